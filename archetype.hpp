@@ -0,0 +1,206 @@
+/// \file archetype.hpp
+/// \brief Implements archetype and registry: entity component storage which
+/// groups entities by their set of components.
+//
+// Copyright 2022 Paul Bowen-Huggett
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARCHETYPE_HPP
+#define ARCHETYPE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "soa_vector.hpp"
+#include "type_characteristics.hpp"
+#include "type_list.hpp"
+
+namespace type_list {
+
+// archetype
+// ~~~~~~~~~
+/// Stores the entities which have exactly the components given by
+/// ComponentList. Entities are held in chunks, each of which is a soa_vector
+/// with room for chunk_rows entities, so that every component of a chunk is a
+/// contiguous column and a scan over some of the components reads only those
+/// columns. A full chunk is never reallocated: a new one is started instead.
+template <typename ComponentList>
+TYPE_LIST_CXX20REQUIRES (is_type_list<ComponentList>)
+class archetype : public archetype<to_flat_t<ComponentList>> {
+  using archetype<to_flat_t<ComponentList>>::archetype;
+};
+
+template <typename... Components>
+class archetype<flat_list<Components...>> {
+public:
+  using components = flat_list<Components...>;
+  using chunk = soa_vector<components>;
+  using size_type = std::size_t;
+
+  static_assert (size_v<unique_t<components>> == sizeof...(Components),
+                 "An archetype must not name a component more than once");
+
+  /// The approximate number of bytes of component values held by each chunk.
+  static constexpr std::size_t chunk_bytes = 16384U;
+  /// The number of entities held by each chunk.
+  static constexpr size_type chunk_rows = std::max (
+      size_type{1},
+      chunk_bytes /
+          std::max (std::size_t{1},
+                    type_characteristics<components>::total_size::value));
+
+  bool empty () const noexcept { return size_ == 0U; }
+  size_type size () const noexcept { return size_; }
+
+  std::vector<chunk>& chunks () noexcept { return chunks_; }
+  std::vector<chunk> const& chunks () const noexcept { return chunks_; }
+
+  /// Appends an entity. There must be one argument for each component.
+  template <typename... Args>
+  void push_back (Args&&... args) {
+    if (chunks_.empty () || chunks_.back ().size () == chunk_rows) {
+      chunk c;
+      c.reserve (chunk_rows);
+      chunks_.push_back (std::move (c));
+    }
+    chunks_.back ().push_back (std::forward<Args> (args)...);
+    ++size_;
+  }
+
+  /// Calls f(c0, c1, ...) for each entity where c0, c1, ... are references to
+  /// the entity's values of the members of Selected. The entities are visited
+  /// in order, one column-wise pass over each chunk.
+  template <typename Selected, typename Function>
+  TYPE_LIST_CXX20REQUIRES (is_type_list<Selected>)
+  void each (Function&& f) {
+    this->each_selected (f, static_cast<to_flat_t<Selected>*> (nullptr));
+  }
+
+private:
+  template <typename... Selected, typename Function>
+  void each_selected (Function& f, flat_list<Selected...>*) {
+    static_assert ((contains_v<components, Selected> && ...),
+                   "each() names a component which is not in the archetype");
+    for (chunk& c : chunks_) {
+      each_row (f, c.size (),
+                c.template data<index_of_v<components, Selected>> ()...);
+    }
+  }
+  template <typename Function, typename... Columns>
+  static void each_row (Function& f, size_type rows,
+                        Columns* const... columns) {
+    for (size_type row = 0; row < rows; ++row) {
+      f (columns[row]...);
+    }
+  }
+
+  std::vector<chunk> chunks_;
+  size_type size_ = 0;
+};
+
+// query
+// ~~~~~
+namespace details {
+
+/// A unary predicate which holds for a list of components if it contains every
+/// member of Include and none of the members of Exclude.
+template <typename Include, typename Exclude>
+struct archetype_matches {
+  template <typename ComponentList>
+  using type = std::bool_constant<
+      size_v<set_difference_t<to_flat_t<Include>, ComponentList>> == 0U &&
+      size_v<set_intersection_t<to_flat_t<Exclude>, ComponentList>> == 0U>;
+};
+
+template <typename ComponentList>
+struct archetype_of {
+  using type = archetype<ComponentList>;
+};
+
+}  // end namespace details
+
+/// Yields a flat_list of the members of ArchetypeList (a type list whose
+/// members are lists of components) which have every component in Include and
+/// none of the components in Exclude. The choice is made entirely at compile
+/// time.
+template <typename ArchetypeList, typename Include,
+          typename Exclude = type_list<>>
+TYPE_LIST_CXX20REQUIRES ((is_type_list<ArchetypeList> &&
+                          is_type_list<Include> && is_type_list<Exclude>))
+struct query
+    : details::build_set<flat_list<>, to_flat_t<ArchetypeList>,
+                         details::archetype_matches<Include, Exclude>> {};
+template <typename ArchetypeList, typename Include,
+          typename Exclude = type_list<>>
+using query_t = typename query<ArchetypeList, Include, Exclude>::type;
+
+// registry
+// ~~~~~~~~
+/// Holds one archetype for each member of ArchetypeList, a type list whose
+/// members are lists of components.
+template <typename ArchetypeList>
+TYPE_LIST_CXX20REQUIRES (is_type_list<ArchetypeList>)
+class registry {
+  struct as_flat {
+    template <typename ComponentList>
+    using type = to_flat<ComponentList>;
+  };
+  struct as_archetype {
+    template <typename ComponentList>
+    using type = details::archetype_of<ComponentList>;
+  };
+
+public:
+  /// The component lists of the archetypes, each as a flat_list.
+  using archetypes = transform_t<to_flat_t<ArchetypeList>, as_flat>;
+
+  /// Returns the archetype whose components are ComponentList.
+  template <typename ComponentList>
+  archetype<to_flat_t<ComponentList>>& get () noexcept {
+    return std::get<index_of_v<archetypes, to_flat_t<ComponentList>>> (
+        storage_);
+  }
+  template <typename ComponentList>
+  archetype<to_flat_t<ComponentList>> const& get () const noexcept {
+    return std::get<index_of_v<archetypes, to_flat_t<ComponentList>>> (
+        storage_);
+  }
+
+  /// Calls f(c0, c1, ...) with references to the values of the members of
+  /// Include for every entity of every archetype which has all of the
+  /// components in Include and none of those in Exclude.
+  template <typename Include, typename Exclude = type_list<>,
+            typename Function>
+  void each (Function&& f) {
+    this->template each_archetype<Include> (
+        f, static_cast<query_t<archetypes, Include, Exclude>*> (nullptr));
+  }
+
+private:
+  template <typename Include, typename... Matches, typename Function>
+  void each_archetype (Function& f, flat_list<Matches...>*) {
+    (this->template get<Matches> ().template each<Include> (f), ...);
+  }
+
+  details::rebind_t<std::tuple, transform_t<archetypes, as_archetype>>
+      storage_;
+};
+
+}  // end namespace type_list
+
+#endif  // ARCHETYPE_HPP
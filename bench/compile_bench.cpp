@@ -0,0 +1,286 @@
+/// \file compile_bench.cpp
+/// \brief Measures the wall time and peak memory consumed by the compiler when
+/// the type_list algorithms are applied to lists of increasing length.
+//
+// Copyright 2022 Paul Bowen-Huggett
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Usage:
+//   compile_bench --source <scaling.cpp> --include <dir> --csv <file>
+//                 --json <file> [--timeout <seconds>] [--size <n>]...
+//                 --compiler <name>=<path>...
+//
+// Each combination of compiler, list representation, algorithm and list size
+// is compiled (with -fsyntax-only) in a child process. The results are written
+// to the CSV and JSON files.
+
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct compiler {
+  std::string name;
+  std::string path;
+};
+
+struct options {
+  std::string source;
+  std::string include;
+  std::string csv;
+  std::string json;
+  unsigned timeout = 300U;
+  std::vector<unsigned long> sizes;
+  std::vector<compiler> compilers;
+};
+
+enum class status { ok, failed, timeout, skipped };
+
+struct measurement {
+  std::string compiler;
+  char const* representation;
+  char const* algorithm;
+  unsigned long size;
+  enum status status;
+  double wall_seconds;
+  long peak_rss_kib;
+};
+
+struct algorithm {
+  char const* name;
+  char const* define;
+};
+constexpr algorithm algorithms[] = {
+    {"make", "-DBENCH_MAKE"},           {"size", "-DBENCH_SIZE_OF"},
+    {"contains", "-DBENCH_CONTAINS"},   {"equal", "-DBENCH_EQUAL"},
+    {"transform", "-DBENCH_TRANSFORM"}, {"foldl", "-DBENCH_FOLDL"},
+};
+constexpr char const* representations[] = {"flat", "cons", "values"};
+
+char const* to_string (status s) {
+  switch (s) {
+  case status::ok: return "ok";
+  case status::failed: return "failed";
+  case status::timeout: return "timeout";
+  case status::skipped: return "skipped";
+  }
+  return "unknown";
+}
+
+void usage (char const* program) {
+  std::cerr << "Usage: " << program
+            << " --source <file> --include <dir> --csv <file> --json <file>"
+               " [--timeout <seconds>] [--size <n>]... --compiler "
+               "<name>=<path>...\n";
+}
+
+bool parse_options (int argc, char const* argv[], options& opts) {
+  for (int index = 1; index < argc; ++index) {
+    std::string const arg = argv[index];
+    if (index + 1 >= argc) {
+      std::cerr << "Missing value for " << arg << '\n';
+      return false;
+    }
+    std::string const value = argv[++index];
+    if (arg == "--source") {
+      opts.source = value;
+    } else if (arg == "--include") {
+      opts.include = value;
+    } else if (arg == "--csv") {
+      opts.csv = value;
+    } else if (arg == "--json") {
+      opts.json = value;
+    } else if (arg == "--timeout") {
+      opts.timeout = static_cast<unsigned> (std::stoul (value));
+    } else if (arg == "--size") {
+      opts.sizes.push_back (std::stoul (value));
+    } else if (arg == "--compiler") {
+      auto const equals = value.find ('=');
+      if (equals == std::string::npos) {
+        std::cerr << "Expected <name>=<path>: " << value << '\n';
+        return false;
+      }
+      opts.compilers.push_back (
+          compiler{value.substr (0, equals), value.substr (equals + 1)});
+    } else {
+      std::cerr << "Unknown option: " << arg << '\n';
+      return false;
+    }
+  }
+  if (opts.sizes.empty ()) {
+    opts.sizes = {10U, 100U, 1000U, 10000U, 50000U};
+  }
+  return !opts.source.empty () && !opts.csv.empty () && !opts.json.empty () &&
+         !opts.compilers.empty ();
+}
+
+/// Runs the compiler in a child process, killing it if it runs for longer
+/// than the timeout. The child's peak resident set size is obtained from
+/// wait4().
+measurement compile (options const& opts, compiler const& cxx,
+                     char const* representation, algorithm const& alg,
+                     unsigned long size) {
+  measurement result{cxx.name, representation, alg.name, size,
+                     status::failed, 0.0, 0L};
+
+  std::vector<std::string> args{cxx.path,
+                                "-std=c++17",
+                                "-fsyntax-only",
+                                "-I" + opts.include,
+                                "-DBENCH_SIZE=" + std::to_string (size),
+                                alg.define};
+  if (std::strcmp (representation, "cons") == 0) {
+    args.emplace_back ("-DBENCH_CONS");
+  } else if (std::strcmp (representation, "values") == 0) {
+    args.emplace_back ("-DBENCH_VALUES");
+  }
+  args.push_back (opts.source);
+  std::vector<char*> argv;
+  for (auto& arg : args) {
+    argv.push_back (arg.data ());
+  }
+  argv.push_back (nullptr);
+
+  auto const start = std::chrono::steady_clock::now ();
+  pid_t const pid = fork ();
+  if (pid == -1) {
+    std::perror ("fork");
+    return result;
+  }
+  if (pid == 0) {
+    // Discard the compiler's diagnostics: a failure is recorded in the status
+    // column of the report.
+    if (std::freopen ("/dev/null", "w", stderr) == nullptr ||
+        std::freopen ("/dev/null", "w", stdout) == nullptr) {
+      std::_Exit (EXIT_FAILURE);
+    }
+    execvp (argv[0], argv.data ());
+    std::_Exit (127);
+  }
+
+  auto const deadline = start + std::chrono::seconds{opts.timeout};
+  int wstatus = 0;
+  rusage usage{};
+  for (;;) {
+    pid_t const waited = wait4 (pid, &wstatus, WNOHANG, &usage);
+    if (waited == pid) {
+      break;
+    }
+    if (waited == -1) {
+      std::perror ("wait4");
+      return result;
+    }
+    if (std::chrono::steady_clock::now () > deadline) {
+      kill (pid, SIGKILL);
+      wait4 (pid, &wstatus, 0, &usage);
+      result.status = status::timeout;
+      break;
+    }
+    std::this_thread::sleep_for (std::chrono::milliseconds{10});
+  }
+  auto const end = std::chrono::steady_clock::now ();
+
+  result.wall_seconds = std::chrono::duration<double> (end - start).count ();
+  result.peak_rss_kib = usage.ru_maxrss;
+  if (result.status != status::timeout) {
+    result.status = WIFEXITED (wstatus) && WEXITSTATUS (wstatus) == 0
+                        ? status::ok
+                        : status::failed;
+  }
+  return result;
+}
+
+void write_csv (std::string const& path,
+                std::vector<measurement> const& measurements) {
+  std::ofstream os{path};
+  os << "compiler,representation,algorithm,size,status,wall_seconds,peak_rss_"
+        "kib\n";
+  for (auto const& m : measurements) {
+    os << m.compiler << ',' << m.representation << ',' << m.algorithm << ','
+       << m.size << ',' << to_string (m.status) << ',' << m.wall_seconds << ','
+       << m.peak_rss_kib << '\n';
+  }
+}
+
+void write_json (std::string const& path,
+                 std::vector<measurement> const& measurements) {
+  std::ofstream os{path};
+  os << "[\n";
+  char const* separator = "";
+  for (auto const& m : measurements) {
+    os << separator << "  {\"compiler\": \"" << m.compiler
+       << "\", \"representation\": \"" << m.representation
+       << "\", \"algorithm\": \"" << m.algorithm << "\", \"size\": " << m.size
+       << ", \"status\": \"" << to_string (m.status)
+       << "\", \"wall_seconds\": " << m.wall_seconds
+       << ", \"peak_rss_kib\": " << m.peak_rss_kib << '}';
+    separator = ",\n";
+  }
+  os << "\n]\n";
+}
+
+}  // end anonymous namespace
+
+int main (int argc, char const* argv[]) {
+  options opts;
+  if (!parse_options (argc, argv, opts)) {
+    usage (argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  std::vector<measurement> measurements;
+  for (auto const& cxx : opts.compilers) {
+    for (char const* representation : representations) {
+      for (auto const& alg : algorithms) {
+        // Once a size fails or times out, larger sizes will do the same so
+        // they are skipped.
+        bool skip = false;
+        for (auto const size : opts.sizes) {
+          if (skip) {
+            measurements.push_back (measurement{cxx.name, representation,
+                                                alg.name, size,
+                                                status::skipped, 0.0, 0L});
+            continue;
+          }
+          measurement const m =
+              compile (opts, cxx, representation, alg, size);
+          std::printf ("%-8s %-5s %-10s %6lu %-8s %9.3fs %9ld KiB\n",
+                       m.compiler.c_str (), m.representation, m.algorithm,
+                       m.size, to_string (m.status), m.wall_seconds,
+                       m.peak_rss_kib);
+          std::fflush (stdout);
+          skip = m.status != status::ok;
+          measurements.push_back (m);
+        }
+      }
+    }
+  }
+
+  write_csv (opts.csv, measurements);
+  write_json (opts.json, measurements);
+  return EXIT_SUCCESS;
+}
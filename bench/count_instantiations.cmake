@@ -0,0 +1,130 @@
+# Counts the template specializations created by each of the type_list search
+# algorithms as the position of the sought member moves along the list.
+#
+# Usage:
+#   cmake -D COMPILER=<path> -D COMPILER_ID=<GNU|Clang> -D SOURCE=<file>
+#         -D INCLUDE_DIR=<dir> [-D SIZE=<n>] -P count_instantiations.cmake
+#
+# GCC reports the number of class and variable/function template
+# specializations when given -fstats; Clang reports the number of
+# specialization declarations when given -Xclang -print-stats.
+#
+# For a flat_list, no algorithm may create more specializations than the eager
+# contains<> baseline for the same hit position: short-circuiting must not make
+# a late hit or a miss more expensive than examining every member.
+
+if (NOT DEFINED SIZE)
+  set (SIZE 512)
+endif ()
+
+if (COMPILER_ID STREQUAL "GNU")
+  set (stats_flags -fstats)
+elseif (COMPILER_ID MATCHES "Clang")
+  set (stats_flags -Xclang -print-stats)
+else ()
+  message (FATAL_ERROR "Instantiation counts are not available for ${COMPILER_ID}")
+endif ()
+
+# Compiles SOURCE with the given preprocessor definitions and stores the number
+# of template specializations reported by the compiler in the variable named by
+# 'result'.
+function (count_specializations result)
+  set (defines)
+  foreach (define ${ARGN})
+    list (APPEND defines "-D${define}")
+  endforeach ()
+  execute_process (
+    COMMAND "${COMPILER}" -std=c++17 -fsyntax-only
+            ${stats_flags} "-I${INCLUDE_DIR}" ${defines} "${SOURCE}"
+    RESULT_VARIABLE status
+    OUTPUT_VARIABLE output
+    ERROR_VARIABLE output
+  )
+  if (NOT status EQUAL 0)
+    message (FATAL_ERROR "Compilation failed (${ARGN}):\n${output}")
+  endif ()
+
+  set (total 0)
+  if (COMPILER_ID STREQUAL "GNU")
+    string (REGEX MATCHALL "(decl|type)_specializations: size [0-9]+, [0-9]+ elements"
+            lines "${output}")
+    foreach (line ${lines})
+      string (REGEX REPLACE ".*, ([0-9]+) elements" "\\1" count "${line}")
+      math (EXPR total "${total} + ${count}")
+    endforeach ()
+  else ()
+    string (REGEX MATCHALL "[0-9]+ (ClassTemplateSpecialization|VarTemplateSpecialization) decls"
+            lines "${output}")
+    foreach (line ${lines})
+      string (REGEX REPLACE "^([0-9]+) .*" "\\1" count "${line}")
+      math (EXPR total "${total} + ${count}")
+    endforeach ()
+  endif ()
+  set (${result} ${total} PARENT_SCOPE)
+endfunction ()
+
+math (EXPR middle "${SIZE} / 2")
+math (EXPR last "${SIZE} - 1")
+set (positions 0 ${middle} ${last} ${SIZE})
+
+set (algorithms
+  1 eager_contains
+  2 contains
+  3 index_of
+  4 find
+  5 any_of
+)
+
+message ("Template specializations beyond those needed to build a list of ${SIZE} members")
+message ("(a hit position of ${SIZE} searches for a type which is not present)\n")
+foreach (representation flat cons)
+  if (representation STREQUAL "cons")
+    set (representation_define BENCH_CONS)
+  else ()
+    set (representation_define)
+  endif ()
+
+  count_specializations (baseline BENCH_SIZE=${SIZE} BENCH_HIT=0
+                         BENCH_ALGORITHM=0 ${representation_define})
+  set (eager)
+
+  set (header "${representation}:")
+  foreach (position ${positions})
+    string (APPEND header "\thit=${position}")
+  endforeach ()
+  message ("${header}")
+
+  set (index 0)
+  list (LENGTH algorithms length)
+  while (index LESS length)
+    list (GET algorithms ${index} number)
+    math (EXPR index "${index} + 1")
+    list (GET algorithms ${index} name)
+    math (EXPR index "${index} + 1")
+
+    set (row "  ${name}")
+    set (column 0)
+    foreach (position ${positions})
+      count_specializations (count BENCH_SIZE=${SIZE} BENCH_HIT=${position}
+                             BENCH_ALGORITHM=${number} ${representation_define})
+      math (EXPR count "${count} - ${baseline}")
+      string (APPEND row "\t${count}")
+      if (name STREQUAL "eager_contains")
+        list (APPEND eager ${count})
+      elseif (representation STREQUAL "flat")
+        list (GET eager ${column} limit)
+        if (count GREATER limit)
+          list (APPEND over "${name} (${representation}, hit=${position})")
+        endif ()
+      endif ()
+      math (EXPR column "${column} + 1")
+    endforeach ()
+    message ("${row}")
+  endwhile ()
+  message ("")
+endforeach ()
+
+if (over)
+  string (REPLACE ";" "\n  " over "${over}")
+  message (FATAL_ERROR "More specializations than eager_contains:\n  ${over}")
+endif ()
@@ -0,0 +1,236 @@
+/// \file dispatch_bench.cpp
+/// \brief Compares the cost of dispatching on a run-time tag using an if-else
+/// chain, visit_index(), std::visit() and virtual functions.
+//
+// Copyright 2022 Paul Bowen-Huggett
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "type_list.hpp"
+#include "visit_index.hpp"
+
+namespace {
+
+constexpr std::size_t messages = 1U << 20;
+constexpr unsigned repeats = 10U;
+
+/// The run-time tags are uniformly distributed so that the branch predictor
+/// cannot learn the sequence.
+std::vector<std::size_t> make_tags (std::size_t kinds) {
+  std::mt19937 gen{42U};
+  std::uniform_int_distribution<std::size_t> dist{0U, kinds - 1U};
+  std::vector<std::size_t> tags (messages);
+  for (auto& tag : tags) {
+    tag = dist (gen);
+  }
+  return tags;
+}
+
+// The handlers are kept out of line, as real message handlers would be, so
+// that the compiler cannot fold the whole dispatch into arithmetic on the tag.
+#if defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__) && !defined(__clang__)
+#define BENCH_NOINLINE __attribute__ ((noipa))
+#else
+#define BENCH_NOINLINE __attribute__ ((noinline))
+#endif
+
+template <std::size_t Index>
+struct message {
+  BENCH_NOINLINE static std::uint64_t handle (std::uint64_t acc) noexcept {
+    return acc * 31U + Index;
+  }
+};
+
+struct base {
+  virtual ~base () noexcept = default;
+  virtual std::uint64_t handle (std::uint64_t acc) const noexcept = 0;
+};
+template <std::size_t Index>
+struct derived final : base {
+  std::uint64_t handle (std::uint64_t acc) const noexcept override {
+    return message<Index>::handle (acc);
+  }
+};
+
+/// Runs f() repeats times and returns the mean time per message in
+/// nanoseconds.
+template <typename Function>
+double time_per_message (Function f, std::uint64_t& sink) {
+  auto const start = std::chrono::steady_clock::now ();
+  for (unsigned r = 0; r < repeats; ++r) {
+    sink += f ();
+  }
+  auto const end = std::chrono::steady_clock::now ();
+  return std::chrono::duration<double, std::nano> (end - start).count () /
+         (static_cast<double> (messages) * repeats);
+}
+
+template <std::size_t... Indices>
+void run (std::index_sequence<Indices...>) {
+  constexpr std::size_t kinds = sizeof...(Indices);
+  using list = type_list::flat_list<message<Indices>...>;
+  using variant = std::variant<message<Indices>...>;
+
+  std::vector<std::size_t> const tags = make_tags (kinds);
+
+  std::vector<variant> variants;
+  std::vector<std::unique_ptr<base>> objects;
+  variants.reserve (messages);
+  objects.reserve (messages);
+  for (auto const tag : tags) {
+    type_list::visit_index<list> (tag, [&] (auto t) {
+      using type = typename decltype (t)::type;
+      variants.emplace_back (type{});
+    });
+    ((tag == Indices ? objects.push_back (std::make_unique<derived<Indices>> ())
+                     : void ()),
+     ...);
+  }
+
+  std::uint64_t sink = 0;
+  double const if_chain = time_per_message (
+      [&] {
+        std::uint64_t acc = 0;
+        for (auto const tag : tags) {
+          // Expands to: if (tag == 0) ... else if (tag == 1) ... and so on.
+          static_cast<void> (((tag == Indices
+                                   ? (acc = message<Indices>::handle (acc), true)
+                                   : false) ||
+                              ...));
+        }
+        return acc;
+      },
+      sink);
+  double const table = time_per_message (
+      [&] {
+        std::uint64_t acc = 0;
+        for (auto const tag : tags) {
+          acc = type_list::visit_index<list> (tag, [acc] (auto t) {
+            return decltype (t)::type::handle (acc);
+          });
+        }
+        return acc;
+      },
+      sink);
+  double const visit = time_per_message (
+      [&] {
+        std::uint64_t acc = 0;
+        for (auto const& v : variants) {
+          acc = std::visit ([acc] (auto const& m) { return m.handle (acc); }, v);
+        }
+        return acc;
+      },
+      sink);
+  double const virtual_call = time_per_message (
+      [&] {
+        std::uint64_t acc = 0;
+        for (auto const& object : objects) {
+          acc = object->handle (acc);
+        }
+        return acc;
+      },
+      sink);
+
+  std::printf ("%5zu %12.2f %12.2f %12.2f %12.2f %10llu\n", kinds, if_chain,
+               table, visit, virtual_call,
+               static_cast<unsigned long long> (sink & 0xFFU));
+}
+
+/// Measures the dispatch of a pair of run-time tags: std::visit() over two
+/// variants against dispatch2().
+template <std::size_t... Indices>
+void run_pairs (std::index_sequence<Indices...>) {
+  constexpr std::size_t kinds = sizeof...(Indices);
+  using list = type_list::flat_list<message<Indices>...>;
+  using variant = std::variant<message<Indices>...>;
+
+  std::vector<std::size_t> const tags1 = make_tags (kinds);
+  std::vector<std::size_t> tags2 = tags1;
+  std::mt19937 gen{7U};
+  std::shuffle (tags2.begin (), tags2.end (), gen);
+
+  std::vector<variant> variants1;
+  std::vector<variant> variants2;
+  variants1.reserve (messages);
+  variants2.reserve (messages);
+  for (std::size_t index = 0; index < messages; ++index) {
+    type_list::visit_index<list> (tags1[index], [&] (auto t) {
+      variants1.emplace_back (typename decltype (t)::type{});
+    });
+    type_list::visit_index<list> (tags2[index], [&] (auto t) {
+      variants2.emplace_back (typename decltype (t)::type{});
+    });
+  }
+
+  std::uint64_t sink = 0;
+  double const table = time_per_message (
+      [&] {
+        std::uint64_t acc = 0;
+        for (std::size_t index = 0; index < messages; ++index) {
+          acc = type_list::dispatch2<list, list> (
+              tags1[index], tags2[index], [acc] (auto a, auto b) {
+                return decltype (b)::type::handle (
+                    decltype (a)::type::handle (acc));
+              });
+        }
+        return acc;
+      },
+      sink);
+  double const visit = time_per_message (
+      [&] {
+        std::uint64_t acc = 0;
+        for (std::size_t index = 0; index < messages; ++index) {
+          acc = std::visit (
+              [acc] (auto const& a, auto const& b) {
+                return b.handle (a.handle (acc));
+              },
+              variants1[index], variants2[index]);
+        }
+        return acc;
+      },
+      sink);
+
+  std::printf ("%5zu %12.2f %12.2f %10llu\n", kinds, table, visit,
+               static_cast<unsigned long long> (sink & 0xFFU));
+}
+
+}  // end anonymous namespace
+
+int main () {
+  std::printf ("Nanoseconds per message\n");
+  std::printf ("%5s %12s %12s %12s %12s %10s\n", "kinds", "if-chain",
+               "visit_index", "std::visit", "virtual", "checksum");
+  run (std::make_index_sequence<4> ());
+  run (std::make_index_sequence<16> ());
+  run (std::make_index_sequence<64> ());
+  run (std::make_index_sequence<200> ());
+
+  std::printf ("\nNanoseconds per pair of messages\n");
+  std::printf ("%5s %12s %12s %10s\n", "kinds", "dispatch2", "std::visit",
+               "checksum");
+  run_pairs (std::make_index_sequence<8> ());
+  run_pairs (std::make_index_sequence<40> ());
+}
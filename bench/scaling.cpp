@@ -0,0 +1,119 @@
+/// \file scaling.cpp
+/// \brief A translation unit used to measure how the cost of compiling the
+/// type_list algorithms scales with the length of the list.
+//
+// Copyright 2022 Paul Bowen-Huggett
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is compiled (but not linked) by compile_bench. The following
+// macros select the list and the algorithm that is applied to it:
+//
+//   BENCH_SIZE  The number of members in the list.
+//   BENCH_CONS  If defined, the list is a chain of type_list cells rather than
+//               a flat_list.
+//   BENCH_VALUES
+//               If defined, the list is a value_list of the member indices
+//               and the algorithms are those of type_list::values.
+//   BENCH_MAKE, BENCH_SIZE_OF, BENCH_CONTAINS, BENCH_EQUAL, BENCH_TRANSFORM,
+//   BENCH_FOLDL
+//               Exactly one of these is defined to select the algorithm.
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "type_list.hpp"
+#include "value_list.hpp"
+
+namespace {
+
+template <std::size_t Index>
+struct member {};
+
+template <typename Sequence>
+struct members;
+template <std::size_t... Indices>
+struct members<std::index_sequence<Indices...>> {
+#if defined(BENCH_VALUES)
+  using type = type_list::value_list<Indices...>;
+#elif defined(BENCH_CONS)
+  using type = type_list::make_t<member<Indices>...>;
+#else
+  using type = type_list::flat_list<member<Indices>...>;
+#endif  // BENCH_VALUES
+};
+
+using list = typename members<std::make_index_sequence<BENCH_SIZE>>::type;
+
+template <typename T>
+struct wrapped {
+  using type = wrapped;
+};
+struct wrap {
+  template <typename T>
+  using type = wrapped<T>;
+};
+
+struct count {
+  template <typename Member, typename Count>
+  using type = std::integral_constant<std::size_t, Count::value + 1U>;
+};
+
+struct value_wrap {
+  constexpr std::size_t operator() (std::size_t v) const { return v + 1U; }
+};
+struct value_count {
+  constexpr std::size_t operator() (std::size_t, std::size_t count) const {
+    return count + 1U;
+  }
+};
+
+}  // end anonymous namespace
+
+#if defined(BENCH_VALUES)
+#if defined(BENCH_MAKE)
+static_assert (sizeof (list*) > 0U);
+#elif defined(BENCH_SIZE_OF)
+static_assert (type_list::values::size_v<list> == BENCH_SIZE);
+#elif defined(BENCH_CONTAINS)
+static_assert (type_list::values::contains_v<list, std::size_t{BENCH_SIZE - 1}>);
+#elif defined(BENCH_EQUAL)
+static_assert (std::is_same_v<list, list>);
+#elif defined(BENCH_TRANSFORM)
+static_assert (
+    sizeof (type_list::values::transform_t<list, value_wrap>*) > 0U);
+#elif defined(BENCH_FOLDL)
+static_assert (type_list::values::foldl_v<list, value_count, std::size_t{0}> ==
+               BENCH_SIZE);
+#else
+#error "No algorithm was selected"
+#endif
+#elif defined(BENCH_MAKE)
+static_assert (sizeof (list*) > 0U);
+#elif defined(BENCH_SIZE_OF)
+static_assert (type_list::size_v<list> == BENCH_SIZE);
+#elif defined(BENCH_CONTAINS)
+static_assert (type_list::contains_v<list, member<BENCH_SIZE - 1>>);
+#elif defined(BENCH_EQUAL)
+static_assert (type_list::equal_v<list, list>);
+#elif defined(BENCH_TRANSFORM)
+static_assert (sizeof (type_list::transform_t<list, wrap>*) > 0U);
+#elif defined(BENCH_FOLDL)
+static_assert (
+    type_list::foldl<list, count,
+                     std::integral_constant<std::size_t, 0U>>::type::value ==
+    BENCH_SIZE);
+#else
+#error "No algorithm was selected"
+#endif
@@ -0,0 +1,94 @@
+/// \file short_circuit.cpp
+/// \brief A translation unit used to count the template instantiations
+/// performed by the type_list search algorithms.
+//
+// Copyright 2022 Paul Bowen-Huggett
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is compiled (but not linked) by count_instantiations.cmake. The
+// following macros select the query:
+//
+//   BENCH_SIZE       The number of members in the list.
+//   BENCH_HIT        The index of the member being sought. A value of
+//                    BENCH_SIZE searches for a type that is not present.
+//   BENCH_CONS       If defined, the list is a chain of type_list cells rather
+//                    than a flat_list.
+//   BENCH_ALGORITHM  One of the BENCH_* algorithm numbers below.
+
+#include <cstddef>
+#include <utility>
+
+#include "type_list.hpp"
+
+#define BENCH_NONE 0
+#define BENCH_EAGER_CONTAINS 1
+#define BENCH_CONTAINS 2
+#define BENCH_INDEX_OF 3
+#define BENCH_FIND 4
+#define BENCH_ANY_OF 5
+
+namespace {
+
+template <std::size_t Index>
+struct member {};
+
+template <typename Sequence>
+struct members;
+template <std::size_t... Indices>
+struct members<std::index_sequence<Indices...>> {
+#ifdef BENCH_CONS
+  using type = type_list::make_t<member<Indices>...>;
+#else
+  using type = type_list::flat_list<member<Indices>...>;
+#endif  // BENCH_CONS
+};
+
+using list = typename members<std::make_index_sequence<BENCH_SIZE>>::type;
+using target = member<BENCH_HIT>;
+constexpr bool expected = BENCH_HIT < BENCH_SIZE;
+
+struct is_target {
+  template <typename T>
+  using type = std::is_same<T, target>;
+};
+
+// The original implementation of contains<> against which the short-circuiting
+// version is compared: '||' does not stop the instantiation of the tail.
+template <typename TypeList, typename Element>
+struct eager_contains
+    : std::bool_constant<
+          std::is_same_v<Element, typename TypeList::first> ||
+          eager_contains<typename TypeList::rest, Element>::value> {};
+template <typename Element>
+struct eager_contains<type_list::type_list<>, Element> : std::false_type {};
+template <typename Element>
+struct eager_contains<type_list::flat_list<>, Element> : std::false_type {};
+
+}  // end anonymous namespace
+
+#if BENCH_ALGORITHM == BENCH_NONE
+static_assert (sizeof (list*) > 0U);
+#elif BENCH_ALGORITHM == BENCH_EAGER_CONTAINS
+static_assert (eager_contains<list, target>::value == expected);
+#elif BENCH_ALGORITHM == BENCH_CONTAINS
+static_assert (type_list::contains_v<list, target> == expected);
+#elif BENCH_ALGORITHM == BENCH_INDEX_OF
+static_assert (type_list::index_of_v<list, target> == BENCH_HIT);
+#elif BENCH_ALGORITHM == BENCH_FIND
+static_assert (type_list::find_v<list, is_target> == BENCH_HIT);
+#elif BENCH_ALGORITHM == BENCH_ANY_OF
+static_assert (type_list::any_of_v<list, is_target> == expected);
+#else
+#error "Unknown BENCH_ALGORITHM"
+#endif
@@ -0,0 +1,67 @@
+# Measures the size of the symbol table and of the debug information in an
+# object file which uses a list built by make_t<> and one built by
+# make_flat_t<>.
+#
+# Usage:
+#   cmake -D COMPILER=<path> -D READELF=<path> -D SOURCE=<file>
+#         -D INCLUDE_DIR=<dir> -D OUTPUT_DIR=<dir> [-D SIZES=<n;n...>]
+#         -P symbol_size.cmake
+
+if (NOT DEFINED SIZES)
+  set (SIZES 10 100 300 1000)
+endif ()
+
+# Compiles SOURCE with the given preprocessor definitions and stores the sizes
+# of the .symtab, .strtab, .debug_info and .debug_str sections of the resulting
+# object file in the variables named <prefix>_symtab, <prefix>_strtab and so
+# on.
+function (section_sizes prefix)
+  set (defines)
+  foreach (define ${ARGN})
+    list (APPEND defines "-D${define}")
+  endforeach ()
+  set (object "${OUTPUT_DIR}/symbol_size.o")
+  execute_process (
+    COMMAND "${COMPILER}" -std=c++17 -g -c
+            "-I${INCLUDE_DIR}" ${defines} "${SOURCE}" -o "${object}"
+    RESULT_VARIABLE status
+    OUTPUT_VARIABLE output
+    ERROR_VARIABLE output
+  )
+  if (NOT status EQUAL 0)
+    message (FATAL_ERROR "Compilation failed (${ARGN}):\n${output}")
+  endif ()
+  execute_process (
+    COMMAND "${READELF}" -S -W "${object}"
+    RESULT_VARIABLE status
+    OUTPUT_VARIABLE output
+    ERROR_VARIABLE output
+  )
+  if (NOT status EQUAL 0)
+    message (FATAL_ERROR "readelf failed:\n${output}")
+  endif ()
+  foreach (section symtab strtab debug_info debug_str)
+    # A section header line has the form:
+    #   [Nr] Name Type Address Offset Size ...
+    if (output MATCHES "\\] \\.${section} +[A-Z_]+ +[0-9a-f]+ [0-9a-f]+ ([0-9a-f]+)")
+      math (EXPR size "0x${CMAKE_MATCH_1}")
+    else ()
+      set (size 0)
+    endif ()
+    set (${prefix}_${section} ${size} PARENT_SCOPE)
+  endforeach ()
+endfunction ()
+
+message ("Section sizes in bytes of an object file using a list of N members")
+message ("N\tlist\t.symtab\t.strtab\t.debug_info\t.debug_str")
+foreach (size ${SIZES})
+  foreach (mode 0 1)
+    if (mode)
+      set (name flat)
+    else ()
+      set (name cons)
+    endif ()
+    section_sizes (s BENCH_SIZE=${size} BENCH_FLAT=${mode})
+    message ("${size}\t${name}\t${s_symtab}\t${s_strtab}\t${s_debug_info}\t\t${s_debug_str}")
+  endforeach ()
+endforeach ()
@@ -0,0 +1,66 @@
+/// \file symbol_size.cpp
+/// \brief A translation unit used to measure the size of the symbol table and
+/// debug information generated for a long type list.
+//
+// Copyright 2022 Paul Bowen-Huggett
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is compiled (but not linked) by symbol_size.cmake. The following
+// macros select the list:
+//
+//   BENCH_SIZE  The number of members in the list.
+//   BENCH_FLAT  If 1, the list is built by make_flat_t<> as a flat_list rather
+//               than by make_t<> as a chain of type_list cells.
+
+#include <cstddef>
+#include <utility>
+
+#include "compact_variant.hpp"
+#include "type_list.hpp"
+#include "visit_index.hpp"
+
+namespace {
+
+template <std::size_t Index>
+struct member {
+  int value;
+};
+
+#if BENCH_FLAT
+template <std::size_t... Indices>
+type_list::make_flat_t<member<Indices>...> make_list (
+    std::index_sequence<Indices...>);
+#else
+template <std::size_t... Indices>
+type_list::make_t<member<Indices>...> make_list (
+    std::index_sequence<Indices...>);
+#endif  // BENCH_FLAT
+
+}  // end anonymous namespace
+
+using list = decltype (make_list (std::make_index_sequence<BENCH_SIZE>{}));
+
+// Each of these functions has external linkage and a parameter whose type
+// names the list so that the list appears in both the symbol table and the
+// debug information.
+std::size_t member_size (std::size_t index) {
+  return type_list::visit_index<list> (
+      index, [] (auto tag) { return sizeof (typename decltype (tag)::type); });
+}
+
+template <typename TypeList>
+std::size_t variant_index (type_list::compact_variant<TypeList> const& v) {
+  return v.index () + type_list::size_v<TypeList>;
+}
+template std::size_t variant_index (type_list::compact_variant<list> const&);
@@ -0,0 +1,386 @@
+/// \file compact_variant.hpp
+/// \brief Implements compact_variant: a tagged union whose storage and
+/// discriminator are no larger than its members require.
+//
+// Copyright 2022 Paul Bowen-Huggett
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMPACT_VARIANT_HPP
+#define COMPACT_VARIANT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "type_characteristics.hpp"
+#include "type_list.hpp"
+#include "visit_index.hpp"
+
+namespace type_list {
+
+namespace details {
+
+/// Yields the smallest unsigned integer type which can represent Value.
+template <std::size_t Value>
+using smallest_unsigned_t = std::conditional_t<
+    Value <= std::numeric_limits<std::uint8_t>::max (), std::uint8_t,
+    std::conditional_t<
+        Value <= std::numeric_limits<std::uint16_t>::max (), std::uint16_t,
+        std::conditional_t<Value <= std::numeric_limits<std::uint32_t>::max (),
+                           std::uint32_t, std::uint64_t>>>;
+
+/// A flat_list of std::integral_constant<std::size_t, I> for I in [0, Size).
+/// visit_index() over this list yields a compile-time index.
+template <typename Sequence>
+struct index_constants;
+template <std::size_t... Indices>
+struct index_constants<std::index_sequence<Indices...>> {
+  using type = flat_list<std::integral_constant<std::size_t, Indices>...>;
+};
+template <std::size_t Size>
+using index_constants_t =
+    typename index_constants<std::make_index_sequence<Size>>::type;
+
+/// The storage and discriminator of a compact_variant. The storage is exactly
+/// as large as the largest member and as aligned as the most aligned member.
+template <typename... Types>
+class variant_storage {
+  using characteristics = type_characteristics<flat_list<Types...>>;
+
+public:
+  static constexpr std::size_t alternatives = sizeof...(Types);
+  /// The discriminator type: large enough to hold every index and also the
+  /// value 'alternatives' which marks a valueless variant.
+  using index_type = smallest_unsigned_t<alternatives>;
+
+  constexpr bool valueless_by_exception () const noexcept {
+    return index_ == alternatives;
+  }
+  constexpr std::size_t index () const noexcept {
+    return valueless_by_exception () ? std::variant_npos : index_;
+  }
+
+protected:
+  template <std::size_t Index>
+  at_t<flat_list<Types...>, Index>* pointer () noexcept {
+    return std::launder (
+        reinterpret_cast<at_t<flat_list<Types...>, Index>*> (storage_));
+  }
+  template <std::size_t Index>
+  at_t<flat_list<Types...>, Index> const* pointer () const noexcept {
+    return std::launder (
+        reinterpret_cast<at_t<flat_list<Types...>, Index> const*> (storage_));
+  }
+
+  /// Constructs member Index in storage which does not currently hold a value.
+  template <std::size_t Index, typename... Args>
+  void construct (Args&&... args) {
+    ::new (static_cast<void*> (storage_))
+        at_t<flat_list<Types...>, Index> (std::forward<Args> (args)...);
+    index_ = static_cast<index_type> (Index);
+  }
+
+  /// Destroys the current value, leaving the variant valueless. If every
+  /// member is trivially destructible, there is nothing to dispatch.
+  void destroy () noexcept {
+    if constexpr ((std::is_trivially_destructible_v<Types> && ...)) {
+      index_ = static_cast<index_type> (alternatives);
+    } else if (!this->valueless_by_exception ()) {
+      visit_index<index_constants_t<alternatives>> (index_, [this] (auto tag) {
+        using T = at_t<flat_list<Types...>, decltype (tag)::type::value>;
+        this->template pointer<decltype (tag)::type::value> ()->~T ();
+      });
+      index_ = static_cast<index_type> (alternatives);
+    }
+  }
+
+private:
+  alignas (characteristics::most_aligned::value)
+      std::byte storage_[characteristics::largest::value];
+  index_type index_ = static_cast<index_type> (alternatives);
+};
+
+/// Supplies the copy, move and destroy operations of a compact_variant. If
+/// every member is trivially copyable, the compiler-generated operations are
+/// used so that the variant is itself trivially copyable.
+template <bool Trivial, typename... Types>
+class variant_base : public variant_storage<Types...> {};
+
+template <typename... Types>
+class variant_base<false, Types...> : public variant_storage<Types...> {
+  using storage = variant_storage<Types...>;
+
+public:
+  variant_base () noexcept = default;
+  variant_base (variant_base const& other) {
+    if (!other.valueless_by_exception ()) {
+      visit_index<index_constants_t<storage::alternatives>> (
+          other.index (), [this, &other] (auto tag) {
+            constexpr std::size_t index = decltype (tag)::type::value;
+            this->template construct<index> (
+                *other.template pointer<index> ());
+          });
+    }
+  }
+  variant_base (variant_base&& other) noexcept (
+      (std::is_nothrow_move_constructible_v<Types> && ...)) {
+    if (!other.valueless_by_exception ()) {
+      visit_index<index_constants_t<storage::alternatives>> (
+          other.index (), [this, &other] (auto tag) {
+            constexpr std::size_t index = decltype (tag)::type::value;
+            this->template construct<index> (
+                std::move (*other.template pointer<index> ()));
+          });
+    }
+  }
+  ~variant_base () noexcept { this->destroy (); }
+
+  variant_base& operator= (variant_base const& other) {
+    if (&other != this) {
+      variant_base copy{other};
+      *this = std::move (copy);
+    }
+    return *this;
+  }
+  variant_base& operator= (variant_base&& other) noexcept (
+      ((std::is_nothrow_move_constructible_v<Types> &&
+        std::is_nothrow_move_assignable_v<Types>) &&
+       ...)) {
+    if (&other == this) {
+      return *this;
+    }
+    if (other.valueless_by_exception ()) {
+      this->destroy ();
+      return *this;
+    }
+    visit_index<index_constants_t<storage::alternatives>> (
+        other.index (), [this, &other] (auto tag) {
+          constexpr std::size_t index = decltype (tag)::type::value;
+          if (this->index () == index) {
+            *this->template pointer<index> () =
+                std::move (*other.template pointer<index> ());
+          } else {
+            // If the move constructor throws, the variant is left valueless.
+            // That cannot happen if every member is nothrow move
+            // constructible.
+            this->destroy ();
+            this->template construct<index> (
+                std::move (*other.template pointer<index> ()));
+          }
+        });
+    return *this;
+  }
+};
+
+}  // end namespace details
+
+// compact variant
+// ~~~~~~~~~~~~~~~
+/// A type-safe union holding a value of one of the members of TypeList. The
+/// storage is exactly as large as the largest member (with the alignment of
+/// the most aligned member) and the discriminator is the smallest unsigned
+/// type which can hold size_v<TypeList>.
+///
+/// If every member is trivially copyable, so is the variant. If every member
+/// is nothrow move constructible, the variant is never valueless: a new value
+/// is constructed in a temporary before the old value is destroyed.
+template <typename TypeList>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+class compact_variant : public compact_variant<to_flat_t<TypeList>> {
+  using base = compact_variant<to_flat_t<TypeList>>;
+
+public:
+  using base::base;
+  using base::operator=;
+};
+
+template <typename... Types>
+class compact_variant<flat_list<Types...>>
+    : public details::variant_base<
+          (std::is_trivially_copyable_v<Types> && ...), Types...> {
+  static_assert (sizeof...(Types) > 0U,
+                 "A compact_variant must have at least one member");
+  using members = flat_list<Types...>;
+  static constexpr bool nothrow_move =
+      (std::is_nothrow_move_constructible_v<Types> && ...);
+
+public:
+  /// Constructs a value-initialized first member.
+  compact_variant () noexcept (
+      std::is_nothrow_default_constructible_v<at_t<members, 0>>) {
+    this->template construct<0> ();
+  }
+  template <std::size_t Index, typename... Args>
+  explicit compact_variant (std::in_place_index_t<Index>, Args&&... args) {
+    this->template construct<Index> (std::forward<Args> (args)...);
+  }
+  template <typename T, typename... Args>
+  explicit compact_variant (std::in_place_type_t<T>, Args&&... args) {
+    this->template construct<index_of_v<members, T>> (
+        std::forward<Args> (args)...);
+  }
+  /// Constructs a value of the member whose type is exactly std::decay_t<T>.
+  template <typename T, typename = std::enable_if_t<
+                            contains_v<members, std::decay_t<T>>>>
+  compact_variant (T&& value) {
+    this->template construct<index_of_v<members, std::decay_t<T>>> (
+        std::forward<T> (value));
+  }
+
+  template <typename T, typename = std::enable_if_t<
+                            contains_v<members, std::decay_t<T>>>>
+  compact_variant& operator= (T&& value) {
+    this->template emplace<index_of_v<members, std::decay_t<T>>> (
+        std::forward<T> (value));
+    return *this;
+  }
+
+  /// Replaces the current value with member Index constructed from args.
+  template <std::size_t Index, typename... Args>
+  at_t<members, Index>& emplace (Args&&... args) {
+    using T = at_t<members, Index>;
+    if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+      this->destroy ();
+      this->template construct<Index> (std::forward<Args> (args)...);
+    } else if constexpr (nothrow_move) {
+      // Construct the new value before destroying the old one so that an
+      // exception leaves the variant unchanged.
+      T temp (std::forward<Args> (args)...);
+      this->destroy ();
+      this->template construct<Index> (std::move (temp));
+    } else {
+      this->destroy ();
+      this->template construct<Index> (std::forward<Args> (args)...);
+    }
+    return *this->template pointer<Index> ();
+  }
+  template <typename T, typename... Args>
+  T& emplace (Args&&... args) {
+    return this->template emplace<index_of_v<members, T>> (
+        std::forward<Args> (args)...);
+  }
+
+  /// Returns true if the variant has no value. This can only happen if the
+  /// construction of a new value threw and some member is not nothrow move
+  /// constructible.
+  constexpr bool valueless_by_exception () const noexcept {
+    if constexpr (nothrow_move) {
+      return false;
+    } else {
+      return details::variant_base<(std::is_trivially_copyable_v<Types> &&
+                                    ...),
+                                   Types...>::valueless_by_exception ();
+    }
+  }
+
+private:
+  // The storage is reached only through these functions, so that user code
+  // cannot destroy or overwrite the current value.
+  template <std::size_t Index, typename TypeList>
+  friend auto* get_if (compact_variant<TypeList>* v) noexcept;
+  template <std::size_t Index, typename TypeList>
+  friend auto const* get_if (compact_variant<TypeList> const* v) noexcept;
+  template <std::size_t Index, typename TypeList>
+  friend auto& get (compact_variant<TypeList>& v);
+  template <std::size_t Index, typename TypeList>
+  friend auto const& get (compact_variant<TypeList> const& v);
+  template <typename Function, typename TypeList>
+  friend decltype (auto) visit (Function&& f, compact_variant<TypeList>& v);
+  template <typename Function, typename TypeList>
+  friend decltype (auto) visit (Function&& f,
+                                compact_variant<TypeList> const& v);
+};
+
+/// Returns true if the variant currently holds a value of type T.
+template <typename T, typename TypeList>
+constexpr bool holds_alternative (
+    compact_variant<TypeList> const& v) noexcept {
+  return v.index () == index_of_v<TypeList, T>;
+}
+
+/// Returns a pointer to member Index of the variant, or nullptr if the variant
+/// holds a different member.
+template <std::size_t Index, typename TypeList>
+auto* get_if (compact_variant<TypeList>* v) noexcept {
+  return v != nullptr && v->index () == Index
+             ? v->template pointer<Index> ()
+             : nullptr;
+}
+template <std::size_t Index, typename TypeList>
+auto const* get_if (compact_variant<TypeList> const* v) noexcept {
+  return v != nullptr && v->index () == Index
+             ? v->template pointer<Index> ()
+             : nullptr;
+}
+template <typename T, typename TypeList>
+T* get_if (compact_variant<TypeList>* v) noexcept {
+  return get_if<index_of_v<TypeList, T>> (v);
+}
+template <typename T, typename TypeList>
+T const* get_if (compact_variant<TypeList> const* v) noexcept {
+  return get_if<index_of_v<TypeList, T>> (v);
+}
+
+/// Returns a reference to member Index of the variant. Throws
+/// std::bad_variant_access if the variant holds a different member.
+template <std::size_t Index, typename TypeList>
+auto& get (compact_variant<TypeList>& v) {
+  if (v.index () != Index) {
+    throw std::bad_variant_access{};
+  }
+  return *v.template pointer<Index> ();
+}
+template <std::size_t Index, typename TypeList>
+auto const& get (compact_variant<TypeList> const& v) {
+  if (v.index () != Index) {
+    throw std::bad_variant_access{};
+  }
+  return *v.template pointer<Index> ();
+}
+template <typename T, typename TypeList>
+T& get (compact_variant<TypeList>& v) {
+  return get<index_of_v<TypeList, T>> (v);
+}
+template <typename T, typename TypeList>
+T const& get (compact_variant<TypeList> const& v) {
+  return get<index_of_v<TypeList, T>> (v);
+}
+
+/// Calls f with a reference to the current value of the variant and returns
+/// the result. Dispatch is a single indirect call through visit_index(). The
+/// variant must not be valueless.
+template <typename Function, typename TypeList>
+decltype (auto) visit (Function&& f, compact_variant<TypeList>& v) {
+  return visit_index<details::index_constants_t<size_v<TypeList>>> (
+      v.index (), [&f, &v] (auto tag) -> decltype (auto) {
+        return std::forward<Function> (f) (
+            *v.template pointer<decltype (tag)::type::value> ());
+      });
+}
+template <typename Function, typename TypeList>
+decltype (auto) visit (Function&& f, compact_variant<TypeList> const& v) {
+  return visit_index<details::index_constants_t<size_v<TypeList>>> (
+      v.index (), [&f, &v] (auto tag) -> decltype (auto) {
+        return std::forward<Function> (f) (
+            *v.template pointer<decltype (tag)::type::value> ());
+      });
+}
+
+}  // end namespace type_list
+
+#endif  // COMPACT_VARIANT_HPP
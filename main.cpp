@@ -1,45 +1,235 @@
 #include <algorithm>
 #include <cstdio>
+#include <new>
+#include <string>
 
+#include "archetype.hpp"
+#include "compact_variant.hpp"
+#include "packed_record.hpp"
+#include "soa_vector.hpp"
+#include "type_characteristics.hpp"
+#include "type_hash.hpp"
 #include "type_list.hpp"
+#include "type_map.hpp"
+#include "type_table.hpp"
+#include "value_list.hpp"
+#include "visit_index.hpp"
 
-template <typename TypeList>
-TYPE_LIST_CXX20REQUIRES (type_list::is_type_list<TypeList>)
-struct type_characteristics {
-private:
-  struct type_size {
-    template <typename T>
-    using type = std::integral_constant<size_t, sizeof (T)>;
+void show_type_characteristics () {
+  using characteristics =
+      type_list::type_characteristics<type_list::make_t<char, long long, int, unsigned>>;
+  std::printf ("size=%zu align=%zu\n", characteristics::largest::value,
+               characteristics::most_aligned::value);
+
+  using flat_characteristics =
+      type_list::type_characteristics<type_list::flat_list<char, long long, int, unsigned>>;
+  static_assert (std::is_same_v<flat_characteristics::largest,
+                                characteristics::largest>);
+  static_assert (std::is_same_v<flat_characteristics::most_aligned,
+                                characteristics::most_aligned>);
+}
+
+void show_packed_record () {
+  using record = type_list::packed_record<
+      type_list::make_t<char, double, short, int, char>>;
+  record r{'a', 1.5, short{2}, 3, 'b'};
+  static_assert (sizeof (record) == record::packed_size);
+  std::printf ("%c %g %d %d %c\n", type_list::get<0> (r), type_list::get<1> (r),
+               type_list::get<2> (r), type_list::get<3> (r),
+               type_list::get<4> (r));
+  std::printf ("naive size=%zu packed size=%zu saved=%zu\n",
+               record::naive_size, record::packed_size, record::bytes_saved);
+}
+
+void show_soa_vector () {
+  using vector = type_list::soa_vector<type_list::make_t<int, double, char>>;
+  static_assert (
+      std::is_same_v<std::iterator_traits<vector::iterator>::iterator_category,
+                     std::forward_iterator_tag>);
+  vector v;
+  for (int i = 0; i < 4; ++i) {
+    v.push_back (i, i * 1.5, static_cast<char> ('a' + i));
+  }
+  double total = 0.0;
+  for (double d : v.column<1> ()) {
+    total += d;
+  }
+  std::printf ("rows=%zu total=%g\n", v.size (), total);
+  for (auto [i, d, c] : v.rows ()) {
+    std::printf ("%d %g %c\n", i, d, c);
+  }
+}
+
+void show_visit_index () {
+  using types = type_list::make_t<char, short, int, long long>;
+  for (std::size_t index = 0; index < type_list::size_v<types>; ++index) {
+    std::size_t const size = type_list::visit_index<types> (
+        index, [] (auto tag) { return sizeof (typename decltype (tag)::type); });
+    std::printf ("sizeof member %zu=%zu\n", index, size);
+  }
+}
+
+void show_dispatch () {
+  using shapes = type_list::make_t<char, short, int>;
+  using others = type_list::flat_list<float, double>;
+  auto const sizes = [] (auto a, auto b) {
+    return sizeof (typename decltype (a)::type) +
+           sizeof (typename decltype (b)::type);
+  };
+  std::printf ("sizes of pair=%zu\n",
+               type_list::dispatch2<shapes, others> (2U, 1U, sizes));
+
+  // A limit of 4 is less than the 6 combinations of the first two lists, so
+  // the first list is dispatched by visit_index().
+  std::size_t const total = type_list::dispatch<
+      type_list::make_t<shapes, others, type_list::make_t<long long>>, 4U> (
+      {{1U, 0U, 0U}}, [] (auto a, auto b, auto c) {
+        return sizeof (typename decltype (a)::type) +
+               sizeof (typename decltype (b)::type) +
+               sizeof (typename decltype (c)::type);
+      });
+  std::printf ("sizes of triple=%zu\n", total);
+}
+
+void show_archetype () {
+  struct position {
+    float x, y;
   };
-  struct type_align {
-    template <typename T>
-    using type = std::integral_constant<size_t, alignof (T)>;
+  struct velocity {
+    float dx, dy;
   };
+  struct frozen {};
+  using moving = type_list::make_t<position, velocity>;
+  using stuck = type_list::make_t<position, velocity, frozen>;
+  using scenery = type_list::make_t<position>;
+  using archetypes = type_list::make_t<moving, stuck, scenery>;
+
+  using movers = type_list::query_t<archetypes, type_list::make_t<velocity>,
+                                    type_list::make_t<frozen>>;
+  static_assert (std::is_same_v<movers, type_list::flat_list<moving>>);
+  static_assert (type_list::size_v<type_list::query_t<
+                     archetypes, type_list::make_t<position>>> == 3U);
+
+  type_list::registry<archetypes> world;
+  for (int i = 0; i < 2000; ++i) {
+    world.get<moving> ().push_back (position{0.0F, 0.0F},
+                                    velocity{1.0F, 2.0F});
+  }
+  world.get<stuck> ().push_back (position{0.0F, 0.0F}, velocity{1.0F, 1.0F},
+                                 frozen{});
+  world.get<scenery> ().push_back (position{5.0F, 5.0F});
+  world.each<type_list::make_t<position, velocity>, type_list::make_t<frozen>> (
+      [] (position& p, velocity const& v) {
+        p.x += v.dx;
+        p.y += v.dy;
+      });
+  float total = 0.0F;
+  world.each<type_list::make_t<position>> (
+      [&total] (position const& p) { total += p.x + p.y; });
+  std::printf ("chunks=%zu total=%g\n", world.get<moving> ().chunks ().size (),
+               static_cast<double> (total));
+}
+
+template <typename T, typename = void>
+struct can_destroy : std::false_type {};
+template <typename T>
+struct can_destroy<T, std::void_t<decltype (std::declval<T&> ().destroy ())>>
+    : std::true_type {};
 
-  struct max_value {
-    template <typename Integral1, typename Integral2>
-    using type =
-        std::integral_constant<typename Integral1::value_type,
-                               std::max (Integral1::value, Integral2::value)>;
+void show_compact_variant () {
+  struct five {
+    char c[5];
   };
+  // The discriminator occupies the tail of the five byte member's storage.
+  using variant = type_list::compact_variant<type_list::make_t<five, int>>;
+  static_assert (sizeof (variant) == 8U);
+  static_assert (std::is_trivially_copyable_v<variant>);
+  static_assert (!can_destroy<variant>::value);
 
-  using sizes_list = type_list::transform_t<TypeList, type_size>;
-  using alignments_type = type_list::transform_t<TypeList, type_align>;
+  type_list::compact_variant<type_list::make_t<int, double, char>> v{2.5};
+  v = 'x';
+  std::printf ("index=%zu sizeof=%zu value=%c\n", v.index (), sizeof (v),
+               type_list::get<char> (v));
+  type_list::visit ([] (auto x) { std::printf ("%zu\n", sizeof (x)); }, v);
+}
 
-public:
-  using largest =
-      typename type_list::foldl<sizes_list, max_value,
-                                std::integral_constant<size_t, 0>>::type;
-  using most_aligned =
-      typename type_list::foldl<alignments_type, max_value,
-                                std::integral_constant<size_t, 0>>::type;
-};
+void show_type_map () {
+  using codecs = type_list::type_map<type_list::make_t<
+      std::pair<char, unsigned char>, std::pair<int, unsigned>,
+      std::pair<long, unsigned long>>>;
+  static_assert (std::is_same_v<type_list::lookup_t<codecs, int>, unsigned>);
+  static_assert (type_list::has_key_v<codecs, long>);
+  static_assert (!type_list::has_key_v<codecs, unsigned>);
+  using fallback = type_list::lookup_or_t<codecs, short, void>;
+  static_assert (std::is_void_v<fallback>);
+  std::printf ("sizeof lookup<long>=%zu\n",
+               sizeof (type_list::lookup_t<codecs, long>));
+}
 
-void show_type_characteristics () {
-  using characteristics =
-      type_characteristics<type_list::make_t<char, long long, int, unsigned>>;
-  std::printf ("size=%zu align=%zu\n", characteristics::largest::value,
-               characteristics::most_aligned::value);
+void show_type_hash () {
+  static_assert (type_list::type_hash_v<int> == type_list::type_hash_v<int>);
+  static_assert (type_list::type_hash_v<int> != type_list::type_hash_v<long>);
+  using config1 = type_list::make_t<int, char, double, char>;
+  using config2 = type_list::flat_list<double, int, char>;
+  static_assert (type_list::set_equal_v<config1, config2>);
+  static_assert (!type_list::set_equal_v<config1, type_list::make_t<int, char>>);
+  static_assert (type_list::size_v<type_list::canonical_t<config1>> == 3U);
+  std::printf ("hash of int=%016llx\n",
+               static_cast<unsigned long long> (type_list::type_hash_v<int>));
+}
+
+void show_type_table () {
+  using types = type_list::make_t<char, double, std::string>;
+  using table = type_list::type_table<types>;
+  constexpr std::size_t id = type_list::type_id_v<types, double>;
+  static_assert (id == 1U);
+  static_assert (table::sizes[id] == sizeof (double));
+  static_assert (table::alignments[id] == alignof (double));
+  static_assert (table::names[0] == "char");
+
+  constexpr std::size_t string_id = type_list::type_id_v<types, std::string>;
+  alignas (std::string) unsigned char from[sizeof (std::string)];
+  alignas (std::string) unsigned char to[sizeof (std::string)];
+  ::new (from) std::string ("copied");
+  table::copy[string_id](to, from);
+  std::printf ("%.*s %s\n", static_cast<int> (table::names[id].size ()),
+               table::names[id].data (),
+               std::launder (reinterpret_cast<std::string*> (to))->c_str ());
+  table::destroy[string_id](to);
+  table::destroy[string_id](from);
+}
+
+void show_value_list () {
+  struct plus {
+    constexpr unsigned operator() (unsigned a, unsigned b) const {
+      return a + b;
+    }
+  };
+  struct twice {
+    constexpr unsigned operator() (unsigned a) const { return a * 2U; }
+  };
+  using numbers = type_list::value_list<3U, 1U, 2U, 3U, 1U>;
+  static_assert (type_list::values::size_v<numbers> == 5U);
+  static_assert (type_list::values::contains_v<numbers, 2U>);
+  static_assert (!type_list::values::contains_v<numbers, 4U>);
+  static_assert (std::is_same_v<type_list::values::sort_t<numbers>,
+                                type_list::value_list<1U, 1U, 2U, 3U, 3U>>);
+  static_assert (std::is_same_v<type_list::values::unique_t<numbers>,
+                                type_list::value_list<3U, 1U, 2U>>);
+  static_assert (
+      std::is_same_v<type_list::values::transform_t<numbers, twice>,
+                     type_list::value_list<6U, 2U, 4U, 6U, 2U>>);
+
+  using sizes = type_list::transform_t<type_list::make_t<char, short, double>,
+                                      type_list::type_size>;
+  constexpr auto const& size_table = type_list::to_array_v<sizes>;
+  static_assert (size_table[2] == sizeof (double));
+  static_assert (type_list::equal_v<type_list::from_array_t<size_table>, sizes>);
+
+  using types = type_list::values::to_types_t<numbers>;
+  static_assert (std::is_same_v<type_list::values::from_types_t<types>, numbers>);
+  std::printf ("sum of values=%u\n",
+               type_list::values::foldl_v<numbers, plus, 0U>);
 }
 
 struct add_one {
@@ -48,6 +238,40 @@ struct add_one {
                                       Integral::value + 1>;
 };
 
+struct sum {
+  template <typename Integral1, typename Integral2>
+  using type = std::integral_constant<typename Integral1::value_type,
+                                      Integral1::value + Integral2::value>;
+};
+
+struct take_member {
+  template <typename Integral, typename Value>
+  using type = Integral;
+};
+
+struct value_of {
+  template <typename Integral>
+  using type = Integral;
+};
+
+struct is_odd {
+  template <typename Integral>
+  using type = std::bool_constant<Integral::value % 2U != 0U>;
+};
+
+template <std::size_t Value>
+struct is_at_least {
+  template <typename Integral>
+  using type = std::bool_constant<(Integral::value >= Value)>;
+};
+
+template <typename FlatList>
+struct concat_singletons;
+template <typename... Types>
+struct concat_singletons<type_list::flat_list<Types...>> {
+  using type = type_list::concat_t<type_list::flat_list<Types>...>;
+};
+
 int main () {
   using one = std::integral_constant<unsigned, 1>;
   using two = std::integral_constant<unsigned, 2>;
@@ -79,13 +303,255 @@ int main () {
       "lists should not be equal: the second has one extra member");
   static_assert (!type_list::equal_v<numbers, plus_one>);
 
+  static_assert (type_list::index_of_v<numbers, two> == 1);
+  static_assert (type_list::index_of_v<numbers, four> == 3,
+                 "The index of a missing member is the size of the list");
+  static_assert (type_list::find_v<plus_one, is_odd> == 1);
+  static_assert (type_list::any_of_v<numbers, is_odd>);
+  static_assert (!type_list::all_of_v<numbers, is_odd>);
+  static_assert (type_list::none_of_v<type_list::make_t<two, four>, is_odd>);
+
+  using zero = std::integral_constant<unsigned, 0>;
+  static_assert (type_list::foldl_t<numbers, sum, zero>::value == 6);
+  static_assert (type_list::foldr_t<numbers, sum, zero>::value == 6);
+  static_assert (type_list::reduce_t<numbers, sum, zero>::value == 6);
+
+  using flat_numbers = type_list::to_flat_t<numbers>;
+  static_assert (std::is_same_v<flat_numbers, type_list::flat_list<one, two, three>>);
+  static_assert (std::is_same_v<type_list::to_cons_t<flat_numbers>, numbers>);
+  static_assert (std::is_same_v<type_list::make_flat_t<one, two, three>,
+                                flat_numbers>);
+  static_assert (type_list::size_v<flat_numbers> == 3);
+  static_assert (type_list::contains_v<flat_numbers, two>);
+  static_assert (!type_list::contains_v<flat_numbers, four>);
+  static_assert (type_list::equal_v<flat_numbers, numbers>);
+  static_assert (type_list::equal_v<numbers, flat_numbers>);
+  static_assert (!type_list::equal_v<flat_numbers, type_list::flat_list<one, two>>);
+  static_assert (type_list::equal_v<type_list::transform_t<flat_numbers, add_one>, plus_one>);
+  static_assert (type_list::index_of_v<flat_numbers, three> == 2);
+  static_assert (std::is_same_v<type_list::at_t<flat_numbers, 0>, one>);
+  static_assert (std::is_same_v<type_list::at_t<flat_numbers, 2>, three>);
+  static_assert (type_list::find_v<flat_numbers, is_odd> == 0);
+  static_assert (type_list::all_of_v<type_list::flat_list<one, three>, is_odd>);
+  static_assert (type_list::foldl_t<flat_numbers, sum, zero>::value == 6);
+  static_assert (type_list::reduce_t<flat_numbers, sum, zero>::value == 6);
+  static_assert (type_list::reduce_t<type_list::iota_list_t<1000>, sum,
+                                    std::integral_constant<std::size_t, 0>>::value ==
+                 499500U);
+
+  static_assert (std::is_same_v<type_list::push_front_t<numbers, zero>,
+                                type_list::make_t<zero, one, two, three>>);
+  static_assert (std::is_same_v<type_list::push_back_t<numbers, four>,
+                                type_list::make_t<one, two, three, four>>);
+  static_assert (std::is_same_v<type_list::push_back_t<flat_numbers, four>,
+                                type_list::flat_list<one, two, three, four>>);
+  static_assert (std::is_same_v<
+                 type_list::concat_t<numbers, type_list::flat_list<four>,
+                                     type_list::make_t<>, plus_one>,
+                 type_list::make_t<one, two, three, four, two, three, four>>);
+  static_assert (std::is_same_v<type_list::concat_t<flat_numbers, numbers>,
+                                type_list::flat_list<one, two, three, one, two, three>>);
+  // Far more lists than the instantiation depth limit.
+  static_assert (std::is_same_v<
+                 concat_singletons<type_list::iota_list_t<8000>>::type,
+                 type_list::iota_list_t<8000>>);
+
+  using duplicates = type_list::make_t<one, two, one, three, two>;
+  static_assert (std::is_same_v<type_list::unique_t<duplicates>, numbers>);
+  static_assert (std::is_same_v<type_list::unique_t<type_list::to_flat_t<duplicates>>,
+                                flat_numbers>);
+  static_assert (std::is_same_v<
+                 type_list::set_union_t<numbers, type_list::make_t<four, two, four>>,
+                 type_list::make_t<one, two, three, four>>);
+  static_assert (std::is_same_v<type_list::set_intersection_t<duplicates, plus_one>,
+                                type_list::make_t<two, three>>);
+  static_assert (std::is_same_v<type_list::set_difference_t<flat_numbers, plus_one>,
+                                type_list::flat_list<one>>);
+  using long_list = type_list::iota_list_t<300>;
+  static_assert (std::is_same_v<
+                 type_list::unique_t<type_list::concat_t<
+                     long_list, type_list::reverse_t<long_list>>>,
+                 long_list>, "repeats are found in earlier blocks");
+  static_assert (std::is_same_v<type_list::unique_t<type_list::repeat_t<one, 200>>,
+                                type_list::flat_list<one>>);
+  static_assert (std::is_same_v<
+                 type_list::set_difference_t<long_list,
+                                             type_list::drop_t<long_list, 100>>,
+                 type_list::take_t<long_list, 100>>);
+
+  static_assert (std::is_same_v<
+                 type_list::sort_t<type_list::make_t<three, one, two>, value_of>,
+                 numbers>);
+  static_assert (std::is_same_v<
+                 type_list::sort_t<flat_numbers, value_of, std::greater<>>,
+                 type_list::flat_list<three, two, one>>);
+  static_assert (std::is_same_v<
+                 type_list::sort_t<type_list::make_t<char, long long, int, short,
+                                                     unsigned char>,
+                                   type_list::type_size>,
+                 type_list::make_t<char, unsigned char, short, int, long long>>,
+                 "sort is stable: char precedes unsigned char");
+  using unsigned_five = std::integral_constant<unsigned, 5U>;
+  using minus_one = std::integral_constant<int, -1>;
+  static_assert (std::is_same_v<
+                 type_list::sort_t<type_list::make_t<unsigned_five, minus_one>,
+                                   value_of>,
+                 type_list::make_t<minus_one, unsigned_five>>,
+                 "mixed signed and unsigned keys compare by value");
+
+  using odd_successors =
+      type_list::filter_view<type_list::transform_view<numbers, add_one>, is_odd>;
+  static_assert (type_list::size_v<odd_successors> == 1U);
+  static_assert (std::is_same_v<type_list::to_flat_t<odd_successors>,
+                                type_list::flat_list<three>>);
+  static_assert (type_list::foldl_t<type_list::filter_view<numbers, is_odd>,
+                                    sum, zero>::value == 4);
+  static_assert (std::is_same_v<
+                 type_list::at_t<type_list::take_view<
+                                     type_list::transform_view<numbers, add_one>, 2>,
+                                 1>,
+                 three>);
+  static_assert (std::is_same_v<
+                 type_list::to_flat_t<type_list::filter_view<
+                     type_list::take_view<numbers, 2>, is_odd>>,
+                 type_list::flat_list<one>>);
+  static_assert (std::is_same_v<
+                 type_list::to_flat_t<type_list::take_view<
+                     type_list::filter_view<numbers, is_odd>, 1>>,
+                 type_list::flat_list<one>>);
+  static_assert (
+      type_list::size_v<type_list::take_view<
+          type_list::transform_view<type_list::make_t<one, two, void>, add_one>,
+          2>> == 2U,
+      "add_one is never applied to the member beyond the take");
+
+  using successors = type_list::transform_view<numbers, add_one>;
+  static_assert (type_list::contains_v<successors, four>);
+  static_assert (type_list::index_of_v<successors, three> == 1U);
+  static_assert (type_list::find_v<successors, is_odd> == 1U);
+  static_assert (type_list::any_of_v<successors, is_odd>);
+  static_assert (!type_list::all_of_v<successors, is_odd>);
+  static_assert (!type_list::none_of_v<successors, is_odd>);
+  static_assert (type_list::equal_v<successors, type_list::make_t<two, three, four>>);
+  static_assert (type_list::equal_v<type_list::transform_t<successors, add_one>,
+                                    type_list::transform_t<plus_one, add_one>>);
+  static_assert (type_list::foldr_t<successors, sum, zero>::value == 9);
+  // A view yields the representation of the list underlying it.
+  using flat_successors = type_list::transform_view<flat_numbers, add_one>;
+  static_assert (std::is_same_v<type_list::take_t<successors, 2>,
+                                type_list::make_t<two, three>>);
+  static_assert (std::is_same_v<type_list::take_t<flat_successors, 2>,
+                                type_list::flat_list<two, three>>);
+  static_assert (std::is_same_v<type_list::push_front_t<successors, one>,
+                                type_list::make_t<one, two, three, four>>);
+  static_assert (std::is_same_v<type_list::push_front_t<flat_successors, one>,
+                                type_list::flat_list<one, two, three, four>>);
+  static_assert (std::is_same_v<type_list::to_cons_t<flat_successors>,
+                                type_list::make_t<two, three, four>>);
+
+  static_assert (std::is_same_v<type_list::filter_t<numbers, is_odd>,
+                                type_list::make_t<one, three>>);
+  static_assert (std::is_same_v<type_list::remove_if_t<flat_numbers, is_odd>,
+                                type_list::flat_list<two>>);
+  static_assert (std::is_same_v<type_list::filter_t<type_list::make_t<>, is_odd>,
+                                type_list::make_t<>>);
+  using odd_even = type_list::partition<type_list::make_t<one, two, three, four>,
+                                        is_odd>;
+  static_assert (std::is_same_v<odd_even::selected, type_list::make_t<one, three>>);
+  static_assert (std::is_same_v<odd_even::rejected, type_list::make_t<two, four>>);
+
+  static_assert (std::is_same_v<type_list::iota_list_t<3>,
+                                type_list::flat_list<
+                                    std::integral_constant<std::size_t, 0>,
+                                    std::integral_constant<std::size_t, 1>,
+                                    std::integral_constant<std::size_t, 2>>>);
+  static_assert (type_list::size_v<type_list::iota_list_t<2000>> == 2000U);
+  using long_indices = type_list::iota_list_t<8000>;
+  static_assert (type_list::find_v<long_indices, is_at_least<7000>> == 7000U);
+  static_assert (type_list::none_of_v<long_indices, is_at_least<8000>>);
+
+  // Longer than Clang's limit of 256 operands to a fold expression.
+  using long_chain = type_list::to_cons_t<type_list::iota_list_t<300>>;
+  static_assert (type_list::size_v<long_chain> == 300U);
+  static_assert (type_list::equal_v<long_chain, type_list::iota_list_t<300>>);
+  static_assert (type_list::size_v<type_list::push_front_t<long_chain, one>> == 301U);
+  static_assert (type_list::contains_v<type_list::iota_list_t<300>,
+                                       std::integral_constant<std::size_t, 299>>);
+  static_assert (type_list::foldl_t<type_list::iota_list_t<300>, sum,
+                                    std::integral_constant<std::size_t, 0>>::value ==
+                 44850U);
+  static_assert (type_list::foldr_t<long_chain, sum,
+                                    std::integral_constant<std::size_t, 0>>::value ==
+                 44850U);
+  static_assert (type_list::foldl_t<type_list::iota_list_t<300>, take_member,
+                                    zero>::value == 299U);
+  static_assert (type_list::foldr_t<type_list::iota_list_t<300>, take_member,
+                                    zero>::value == 0U);
+  static_assert (type_list::equal_v<type_list::transform_t<long_chain, add_one>,
+                                    type_list::drop_t<type_list::iota_list_t<301>, 1>>);
+  using longer_chain = type_list::to_cons_t<type_list::iota_list_t<2000>>;
+  static_assert (type_list::contains_v<longer_chain,
+                                       std::integral_constant<std::size_t, 1999>>);
+  static_assert (type_list::index_of_v<longer_chain,
+                                       std::integral_constant<std::size_t, 1999>> ==
+                 1999U);
+  static_assert (type_list::find_v<longer_chain, is_at_least<3>> == 3U);
+  static_assert (type_list::find_v<longer_chain, is_at_least<1500>> == 1500U);
+  static_assert (!type_list::any_of_v<longer_chain, is_at_least<2000>>);
+  static_assert (std::is_same_v<type_list::repeat_t<one, 3>,
+                                type_list::flat_list<one, one, one>>);
+  static_assert (std::is_same_v<type_list::make_index_list_t<3>,
+                                type_list::value_list<std::size_t{0}, std::size_t{1},
+                                                      std::size_t{2}>>);
+
+  using five = std::integral_constant<unsigned, 5>;
+  using one_to_five = type_list::make_t<one, two, three, four, five>;
+  static_assert (std::is_same_v<type_list::take_t<one_to_five, 2>,
+                                type_list::make_t<one, two>>);
+  static_assert (std::is_same_v<type_list::drop_t<one_to_five, 3>,
+                                type_list::make_t<four, five>>);
+  static_assert (std::is_same_v<type_list::take_t<flat_numbers, 9>, flat_numbers>);
+  static_assert (std::is_same_v<type_list::slice_t<one_to_five, 1, 3>,
+                                type_list::make_t<two, three>>);
+  static_assert (std::is_same_v<type_list::split_at<flat_numbers, 1>::tail,
+                                type_list::flat_list<two, three>>);
+  static_assert (std::is_same_v<
+                 type_list::chunk_t<type_list::to_flat_t<one_to_five>, 2>,
+                 type_list::flat_list<type_list::flat_list<one, two>,
+                                      type_list::flat_list<three, four>,
+                                      type_list::flat_list<five>>>);
+  static_assert (type_list::size_v<type_list::chunk_t<type_list::iota_list_t<1000>,
+                                                      64>> == 16U);
+
+  static_assert (std::is_same_v<type_list::reverse_t<numbers>,
+                                type_list::make_t<three, two, one>>);
+  static_assert (std::is_same_v<type_list::rotate_t<flat_numbers, 1>,
+                                type_list::flat_list<two, three, one>>);
+  static_assert (std::is_same_v<type_list::insert_at_t<numbers, 1, zero>,
+                                type_list::make_t<one, zero, two, three>>);
+  static_assert (std::is_same_v<type_list::erase_at_t<numbers, 0>,
+                                type_list::make_t<two, three>>);
+  static_assert (std::is_same_v<type_list::replace_at_t<flat_numbers, 2, four>,
+                                type_list::flat_list<one, two, four>>);
+
   std::printf ("length of types=%zu\n", type_list::size_v<numbers>);
-  std::printf ("%u %u %u\n", numbers::first::value, numbers::rest::first::value,
-               numbers::rest::rest::first::value);
+  std::printf ("%u %u %u\n", type_list::at_t<numbers, 0>::value,
+               type_list::at_t<numbers, 1>::value,
+               type_list::at_t<numbers, 2>::value);
   std::printf ("length of plusone=%zu\n", type_list::size_v<plus_one>);
-  std::printf ("%u %u %u\n", plus_one::first::value,
-               plus_one::rest::first::value,
-               plus_one::rest::rest::first::value);
+  std::printf ("%u %u %u\n", type_list::at_t<plus_one, 0>::value,
+               type_list::at_t<plus_one, 1>::value,
+               type_list::at_t<plus_one, 2>::value);
 
   show_type_characteristics ();
+  show_packed_record ();
+  show_soa_vector ();
+  show_visit_index ();
+  show_dispatch ();
+  show_archetype ();
+  show_compact_variant ();
+  show_type_map ();
+  show_type_hash ();
+  show_type_table ();
+  show_value_list ();
 }
@@ -0,0 +1,204 @@
+/// \file packed_record.hpp
+/// \brief Implements packed_record: a record whose members are laid out in an
+/// order which minimises padding.
+//
+// Copyright 2022 Paul Bowen-Huggett
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PACKED_RECORD_HPP
+#define PACKED_RECORD_HPP
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "type_characteristics.hpp"
+#include "type_list.hpp"
+
+namespace type_list {
+
+namespace details {
+
+constexpr std::size_t align_up (std::size_t value, std::size_t alignment) {
+  return (value + alignment - 1U) / alignment * alignment;
+}
+
+/// Yields the indices of the members in order of descending alignment.
+/// Members with equal alignment keep their declaration order.
+template <std::size_t Size>
+constexpr std::array<std::size_t, Size> order_by_alignment (
+    std::array<std::size_t, Size> const& alignments) {
+  std::array<std::size_t, Size> order{};
+  for (std::size_t index = 0; index < Size; ++index) {
+    order[index] = index;
+  }
+  for (std::size_t index = 1; index < Size; ++index) {
+    std::size_t const value = order[index];
+    std::size_t position = index;
+    for (; position > 0 && alignments[order[position - 1]] < alignments[value];
+         --position) {
+      order[position] = order[position - 1];
+    }
+    order[position] = value;
+  }
+  return order;
+}
+
+/// Yields the size of a struct whose members have the given sizes and
+/// alignments and are declared in the given order.
+template <std::size_t Size>
+constexpr std::size_t struct_size (std::array<std::size_t, Size> const& sizes,
+                                   std::array<std::size_t, Size> const& alignments) {
+  std::size_t offset = 0;
+  std::size_t alignment = 1;
+  for (std::size_t index = 0; index < Size; ++index) {
+    offset = align_up (offset, alignments[index]) + sizes[index];
+    alignment = std::max (alignment, alignments[index]);
+  }
+  return align_up (offset, alignment);
+}
+
+/// Yields true if each of Types can be constructed from the corresponding
+/// member of Args.
+template <typename FlatList, typename ArgList,
+          bool SameSize = (size_v<FlatList> == size_v<ArgList>)>
+struct constructible : std::false_type {};
+template <typename... Types, typename... Args>
+struct constructible<flat_list<Types...>, flat_list<Args...>, true>
+    : std::conjunction<std::is_constructible<Types, Args>...> {};
+
+/// Holds the member of a packed_record whose declaration index is Index.
+template <std::size_t Index, typename T>
+struct record_member {
+  record_member () = default;
+  template <typename Arg>
+  record_member (std::in_place_t, Arg&& arg) : value (std::forward<Arg> (arg)) {}
+  T value;
+};
+
+/// The storage of a packed_record. Its base classes, one per member, are
+/// declared in storage order; each is labelled with the declaration index of
+/// its member so that the member can be found by overload resolution.
+template <typename FlatList, typename Order>
+struct record_storage;
+template <typename... Types, std::size_t... Order>
+struct record_storage<flat_list<Types...>, std::index_sequence<Order...>>
+    : record_member<Order, at_t<flat_list<Types...>, Order>>... {
+  record_storage () = default;
+  template <typename Tuple>
+  record_storage (std::in_place_t, Tuple&& args)
+      : record_member<Order, at_t<flat_list<Types...>, Order>> (
+            std::in_place, std::get<Order> (std::forward<Tuple> (args)))... {}
+};
+
+template <std::size_t Index, typename T>
+T& record_get (record_member<Index, T>& m) noexcept {
+  return m.value;
+}
+template <std::size_t Index, typename T>
+T const& record_get (record_member<Index, T> const& m) noexcept {
+  return m.value;
+}
+
+template <typename FlatList, typename Indices>
+struct record_layout;
+template <typename... Types, std::size_t... Indices>
+struct record_layout<flat_list<Types...>, std::index_sequence<Indices...>> {
+  static constexpr std::array<std::size_t, sizeof...(Types)> sizes{
+      sizeof (Types)...};
+  static constexpr std::array<std::size_t, sizeof...(Types)> alignments{
+      alignof (Types)...};
+  static constexpr std::array<std::size_t, sizeof...(Types)> order =
+      order_by_alignment (alignments);
+
+  using storage = record_storage<flat_list<Types...>,
+                                 std::index_sequence<order[Indices]...>>;
+  static constexpr std::size_t naive_size = struct_size (sizes, alignments);
+};
+
+}  // end namespace details
+
+// packed record
+// ~~~~~~~~~~~~~
+/// A record with one member for each member of TypeList. The members are
+/// stored in order of descending alignment so that no padding is needed
+/// between them but get<I>() continues to refer to them by their position in
+/// TypeList.
+template <typename TypeList>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+class packed_record {
+  using flat = to_flat_t<TypeList>;
+  using layout =
+      details::record_layout<flat, std::make_index_sequence<size_v<flat>>>;
+  using characteristics = type_characteristics<flat>;
+
+public:
+  using members = TypeList;
+
+  /// The size of a struct with the same members declared in the order given
+  /// by TypeList.
+  static constexpr std::size_t naive_size = layout::naive_size;
+  /// The size of the record: the sum of the member sizes rounded up to the
+  /// largest member alignment.
+  static constexpr std::size_t packed_size =
+      size_v<flat> == 0U ? 0U
+                         : details::align_up (
+                               characteristics::total_size::value,
+                               characteristics::most_aligned::value);
+  /// The number of bytes saved by reordering the members.
+  static constexpr std::size_t bytes_saved = naive_size - packed_size;
+
+  packed_record () = default;
+  /// Constructs the record from values for each member, given in the order of
+  /// TypeList.
+  template <typename... Args,
+            typename = std::enable_if_t<
+                sizeof...(Args) != 0U &&
+                details::constructible<flat, flat_list<Args&&...>>::value>>
+  explicit packed_record (Args&&... args)
+      : storage_ (std::in_place,
+                  std::forward_as_tuple (std::forward<Args> (args)...)) {}
+
+  /// Returns the member at position Index of TypeList.
+  template <std::size_t Index>
+  at_t<flat, Index>& get () noexcept {
+    return details::record_get<Index> (storage_);
+  }
+  template <std::size_t Index>
+  at_t<flat, Index> const& get () const noexcept {
+    return details::record_get<Index> (storage_);
+  }
+
+private:
+  static_assert (size_v<flat> == 0U ||
+                     sizeof (typename layout::storage) == packed_size,
+                 "the members of the record were not laid out in the expected "
+                 "order");
+  typename layout::storage storage_;
+};
+
+template <std::size_t Index, typename TypeList>
+decltype (auto) get (packed_record<TypeList>& record) noexcept {
+  return record.template get<Index> ();
+}
+template <std::size_t Index, typename TypeList>
+decltype (auto) get (packed_record<TypeList> const& record) noexcept {
+  return record.template get<Index> ();
+}
+
+}  // end namespace type_list
+
+#endif  // PACKED_RECORD_HPP
@@ -0,0 +1,386 @@
+/// \file soa_vector.hpp
+/// \brief Implements soa_vector: a sequence container which stores each member
+/// of its element type list in a separate column.
+//
+// Copyright 2022 Paul Bowen-Huggett
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOA_VECTOR_HPP
+#define SOA_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus >= 202002L
+#include <span>
+#endif  // __cplusplus >= 202002L
+
+#include "type_list.hpp"
+
+namespace type_list {
+
+namespace details {
+
+/// A unary operation for transform<> which yields a pointer to a type.
+struct add_pointer {
+  template <typename T>
+  using type = std::add_pointer<T>;
+};
+
+/// Instantiates Template with the members of a flat_list.
+template <template <typename...> class Template, typename FlatList>
+struct rebind;
+template <template <typename...> class Template, typename... Types>
+struct rebind<Template, flat_list<Types...>> {
+  using type = Template<Types...>;
+};
+template <template <typename...> class Template, typename FlatList>
+using rebind_t = typename rebind<Template, FlatList>::type;
+
+/// Moves count objects from an array into uninitialized storage. As with
+/// std::move_if_noexcept(), the objects are copied instead if their move
+/// constructor may throw and they can be copied.
+template <typename T>
+void relocate (T* const from, std::size_t const count, T* const to) {
+  if constexpr (!std::is_nothrow_move_constructible_v<T> &&
+                std::is_copy_constructible_v<T>) {
+    std::uninitialized_copy (from, from + count, to);
+  } else {
+    std::uninitialized_move (from, from + count, to);
+  }
+}
+
+}  // end namespace details
+
+// soa vector
+// ~~~~~~~~~~
+/// A sequence container in which each row holds one value of each member of
+/// TypeList. Rather than storing rows contiguously, the values of each member
+/// are stored in their own contiguous column so that a scan which touches
+/// only some of the members reads only those columns. All of the columns share
+/// a single allocation.
+template <typename TypeList>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+class soa_vector : public soa_vector<to_flat_t<TypeList>> {
+  using soa_vector<to_flat_t<TypeList>>::soa_vector;
+};
+
+template <typename... Types>
+class soa_vector<flat_list<Types...>> {
+  using members = flat_list<Types...>;
+  using column_pointers =
+      details::rebind_t<std::tuple, transform_t<members, details::add_pointer>>;
+  static constexpr std::size_t columns = size_v<members>;
+
+public:
+  using size_type = std::size_t;
+  /// The alignment of the start of each column.
+  static constexpr std::size_t column_alignment =
+      std::max ({std::size_t{64}, alignof (Types)...});
+
+  /// A forward iterator over the rows of the container. Dereferencing yields a
+  /// tuple of references to the values in each column.
+  template <bool IsConst>
+  class row_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::tuple<Types...>;
+    using difference_type = std::ptrdiff_t;
+    using reference =
+        std::conditional_t<IsConst, std::tuple<Types const&...>,
+                           std::tuple<Types&...>>;
+    using pointer = void;
+
+    row_iterator () noexcept = default;
+    row_iterator (column_pointers const& columns, size_type index) noexcept
+        : columns_{columns}, index_{index} {}
+
+    reference operator* () const noexcept {
+      return deref (std::index_sequence_for<Types...>{});
+    }
+    row_iterator& operator++ () noexcept {
+      ++index_;
+      return *this;
+    }
+    row_iterator operator++ (int) noexcept {
+      auto const prev = *this;
+      ++index_;
+      return prev;
+    }
+    friend bool operator== (row_iterator const& lhs,
+                            row_iterator const& rhs) noexcept {
+      return lhs.index_ == rhs.index_;
+    }
+    friend bool operator!= (row_iterator const& lhs,
+                            row_iterator const& rhs) noexcept {
+      return !(lhs == rhs);
+    }
+
+  private:
+    template <std::size_t... Indices>
+    reference deref (std::index_sequence<Indices...>) const noexcept {
+      return reference{std::get<Indices> (columns_)[index_]...};
+    }
+
+    column_pointers columns_{};
+    size_type index_ = 0;
+  };
+  using iterator = row_iterator<false>;
+  using const_iterator = row_iterator<true>;
+
+  /// The range of rows returned by rows().
+  template <typename Iterator>
+  class row_range {
+  public:
+    row_range (Iterator first, Iterator last) noexcept
+        : first_{first}, last_{last} {}
+    Iterator begin () const noexcept { return first_; }
+    Iterator end () const noexcept { return last_; }
+
+  private:
+    Iterator first_;
+    Iterator last_;
+  };
+
+  soa_vector () noexcept = default;
+  /// Delegates to the default constructor so that, if copying a value
+  /// throws, the destructor releases the storage.
+  soa_vector (soa_vector const& other) : soa_vector{} {
+    this->reserve (other.size_);
+    this->copy_columns (other, std::index_sequence_for<Types...>{});
+    size_ = other.size_;
+  }
+  soa_vector (soa_vector&& other) noexcept { this->swap (other); }
+  ~soa_vector () noexcept {
+    this->clear ();
+    this->deallocate ();
+  }
+
+  soa_vector& operator= (soa_vector const& other) {
+    if (&other != this) {
+      soa_vector copy{other};
+      this->swap (copy);
+    }
+    return *this;
+  }
+  soa_vector& operator= (soa_vector&& other) noexcept {
+    if (&other != this) {
+      soa_vector temp{std::move (other)};
+      this->swap (temp);
+    }
+    return *this;
+  }
+
+  void swap (soa_vector& other) noexcept {
+    std::swap (storage_, other.storage_);
+    std::swap (columns_, other.columns_);
+    std::swap (size_, other.size_);
+    std::swap (capacity_, other.capacity_);
+  }
+
+  bool empty () const noexcept { return size_ == 0U; }
+  size_type size () const noexcept { return size_; }
+  size_type capacity () const noexcept { return capacity_; }
+
+  /// Ensures that the container can hold at least new_capacity rows without
+  /// further allocation.
+  void reserve (size_type new_capacity) {
+    if (new_capacity > capacity_) {
+      this->reallocate (new_capacity);
+    }
+  }
+
+  /// Appends a row. There must be one argument for each column. The arguments
+  /// must not refer to values held by the container.
+  template <typename... Args>
+  void push_back (Args&&... args) {
+    static_assert (sizeof...(Args) == columns,
+                   "push_back() requires one value for each column");
+    if (size_ == capacity_) {
+      this->reallocate (std::max (size_type{8}, capacity_ * 2U));
+    }
+    this->construct_row (std::index_sequence_for<Types...>{},
+                         std::forward<Args> (args)...);
+    ++size_;
+  }
+
+  /// Destroys all of the rows. The capacity is unchanged.
+  void clear () noexcept {
+    this->destroy_columns (std::index_sequence_for<Types...>{}, size_);
+    size_ = 0U;
+  }
+
+  /// Returns a pointer to the first value in column Index.
+  template <std::size_t Index>
+  at_t<members, Index>* data () noexcept {
+    return std::get<Index> (columns_);
+  }
+  template <std::size_t Index>
+  at_t<members, Index> const* data () const noexcept {
+    return std::get<Index> (columns_);
+  }
+
+#if __cplusplus >= 202002L
+  /// Returns a span covering all of the values in column Index.
+  template <std::size_t Index>
+  std::span<at_t<members, Index>> column () noexcept {
+    return {std::get<Index> (columns_), size_};
+  }
+  template <std::size_t Index>
+  std::span<at_t<members, Index> const> column () const noexcept {
+    return {std::get<Index> (columns_), size_};
+  }
+#endif  // __cplusplus >= 202002L
+
+  iterator begin () noexcept { return {columns_, 0U}; }
+  iterator end () noexcept { return {columns_, size_}; }
+  const_iterator begin () const noexcept { return {columns_, 0U}; }
+  const_iterator end () const noexcept { return {columns_, size_}; }
+
+  /// Returns a range which visits each row as a tuple of references.
+  row_range<iterator> rows () noexcept { return {begin (), end ()}; }
+  row_range<const_iterator> rows () const noexcept {
+    return {begin (), end ()};
+  }
+
+private:
+  static constexpr std::size_t align_up (std::size_t value) noexcept {
+    return (value + column_alignment - 1U) / column_alignment *
+           column_alignment;
+  }
+  /// Returns the number of bytes needed for columns holding capacity rows.
+  static std::size_t allocation_size (size_type capacity) noexcept {
+    std::size_t bytes = 0;
+    ((bytes = align_up (bytes) + sizeof (Types) * capacity), ...);
+    return bytes;
+  }
+
+  /// Moves the rows into a new allocation with room for new_capacity rows.
+  void reallocate (size_type new_capacity) {
+    std::byte* const storage = static_cast<std::byte*> (::operator new (
+        allocation_size (new_capacity), std::align_val_t{column_alignment}));
+    column_pointers columns;
+    std::size_t offset = 0;
+    this->assign_columns (storage, columns, offset,
+                          std::index_sequence_for<Types...>{}, new_capacity);
+    try {
+      this->relocate_columns (columns, std::index_sequence_for<Types...>{});
+    } catch (...) {
+      ::operator delete (storage, std::align_val_t{column_alignment});
+      throw;
+    }
+    this->destroy_columns (std::index_sequence_for<Types...>{}, size_);
+    this->deallocate ();
+    storage_ = storage;
+    columns_ = columns;
+    capacity_ = new_capacity;
+  }
+
+  template <std::size_t... Indices>
+  static void assign_columns (std::byte* const storage,
+                              column_pointers& columns, std::size_t& offset,
+                              std::index_sequence<Indices...>,
+                              size_type capacity) noexcept {
+    ((offset = align_up (offset),
+      std::get<Indices> (columns) =
+          reinterpret_cast<at_t<members, Indices>*> (storage + offset),
+      offset += sizeof (at_t<members, Indices>) * capacity),
+     ...);
+  }
+
+  /// Relocates each column in turn. If relocation of a column throws, the
+  /// columns that have already been copied are destroyed.
+  template <std::size_t... Indices>
+  void relocate_columns (column_pointers const& to,
+                         std::index_sequence<Indices...>) {
+    std::size_t done = 0;
+    try {
+      ((details::relocate (std::get<Indices> (columns_), size_,
+                           std::get<Indices> (to)),
+        ++done),
+       ...);
+    } catch (...) {
+      ((Indices < done
+            ? static_cast<void> (std::destroy_n (std::get<Indices> (to), size_))
+            : void ()),
+       ...);
+      throw;
+    }
+  }
+
+  /// Constructs the values of a new row at index size_. If construction of a
+  /// value throws, the values that have already been constructed are
+  /// destroyed.
+  template <std::size_t... Indices, typename... Args>
+  void construct_row (std::index_sequence<Indices...>, Args&&... args) {
+    std::size_t done = 0;
+    try {
+      ((::new (static_cast<void*> (std::get<Indices> (columns_) + size_))
+            at_t<members, Indices> (std::forward<Args> (args)),
+        ++done),
+       ...);
+    } catch (...) {
+      ((Indices < done ? std::destroy_at (std::get<Indices> (columns_) + size_)
+                       : void ()),
+       ...);
+      throw;
+    }
+  }
+
+  template <std::size_t... Indices>
+  void copy_columns (soa_vector const& other,
+                     std::index_sequence<Indices...>) {
+    std::size_t done = 0;
+    try {
+      ((std::uninitialized_copy_n (std::get<Indices> (other.columns_),
+                                   other.size_, std::get<Indices> (columns_)),
+        ++done),
+       ...);
+    } catch (...) {
+      ((Indices < done ? static_cast<void> (std::destroy_n (
+                             std::get<Indices> (columns_), other.size_))
+                       : void ()),
+       ...);
+      throw;
+    }
+  }
+
+  template <std::size_t... Indices>
+  void destroy_columns (std::index_sequence<Indices...>,
+                        size_type count) noexcept {
+    (std::destroy_n (std::get<Indices> (columns_), count), ...);
+  }
+
+  void deallocate () noexcept {
+    if (storage_ != nullptr) {
+      ::operator delete (storage_, std::align_val_t{column_alignment});
+      storage_ = nullptr;
+    }
+  }
+
+  std::byte* storage_ = nullptr;
+  column_pointers columns_{};
+  size_type size_ = 0;
+  size_type capacity_ = 0;
+};
+
+}  // end namespace type_list
+
+#endif  // SOA_VECTOR_HPP
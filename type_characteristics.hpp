@@ -0,0 +1,75 @@
+/// \file type_characteristics.hpp
+/// \brief Computes the size and alignment characteristics of the members of a
+/// type list.
+//
+// Copyright 2022 Paul Bowen-Huggett
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TYPE_CHARACTERISTICS_HPP
+#define TYPE_CHARACTERISTICS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include "type_list.hpp"
+
+namespace type_list {
+
+/// A unary operation for transform<> which yields the size of a type.
+struct type_size {
+  template <typename T>
+  using type = std::integral_constant<std::size_t, sizeof (T)>;
+};
+/// A unary operation for transform<> which yields the alignment of a type.
+struct type_align {
+  template <typename T>
+  using type = std::integral_constant<std::size_t, alignof (T)>;
+};
+
+template <typename TypeList>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct type_characteristics {
+private:
+  struct max_value {
+    template <typename Integral1, typename Integral2>
+    using type =
+        std::integral_constant<typename Integral1::value_type,
+                               std::max (Integral1::value, Integral2::value)>;
+  };
+  struct sum {
+    template <typename Integral1, typename Integral2>
+    using type = std::integral_constant<typename Integral1::value_type,
+                                        Integral1::value + Integral2::value>;
+  };
+
+  // The sizes and alignments are lazy views, so no list of them is built
+  // before it is folded.
+  using sizes_list = transform_view<TypeList, type_size>;
+  using alignments_type = transform_view<TypeList, type_align>;
+
+public:
+  using largest = typename foldl<sizes_list, max_value,
+                                 std::integral_constant<std::size_t, 0>>::type;
+  using most_aligned =
+      typename foldl<alignments_type, max_value,
+                     std::integral_constant<std::size_t, 0>>::type;
+  /// The sum of the sizes of all of the members.
+  using total_size = typename foldl<sizes_list, sum,
+                                    std::integral_constant<std::size_t, 0>>::type;
+};
+
+}  // end namespace type_list
+
+#endif  // TYPE_CHARACTERISTICS_HPP
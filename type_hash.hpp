@@ -0,0 +1,129 @@
+/// \file type_hash.hpp
+/// \brief Implements type_hash: a constexpr hash of the identity of a type,
+/// type_name: the name of a type, and canonical: a list ordered and
+/// deduplicated by its hashes.
+//
+// Copyright 2022 Paul Bowen-Huggett
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TYPE_HASH_HPP
+#define TYPE_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include "type_list.hpp"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define TYPE_LIST_FUNCTION_SIGNATURE __FUNCSIG__
+#else
+#define TYPE_LIST_FUNCTION_SIGNATURE __PRETTY_FUNCTION__
+#endif  // defined(_MSC_VER) && !defined(__clang__)
+
+namespace type_list {
+
+namespace details {
+
+/// Yields the 64-bit FNV-1a hash of a string.
+constexpr std::uint64_t fnv1a (std::string_view str) {
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for (char const c : str) {
+    hash ^= static_cast<unsigned char> (c);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+/// Yields the signature of this function, which names T.
+template <typename T>
+constexpr char const* signature () {
+  return TYPE_LIST_FUNCTION_SIGNATURE;
+}
+
+/// Extracts the name of T from the signature of signature<T>(). GCC and Clang
+/// write "... [with T = int]" or "... [T = int]"; MSVC writes
+/// "... signature<int>(void)".
+template <typename T>
+constexpr std::string_view signature_name () {
+  std::string_view const text = signature<T> ();
+#if defined(_MSC_VER) && !defined(__clang__)
+  constexpr std::string_view prefix = "signature<";
+  constexpr std::string_view suffix = ">(void)";
+#else
+  constexpr std::string_view prefix = "T = ";
+  constexpr std::string_view suffix = "]";
+#endif  // defined(_MSC_VER) && !defined(__clang__)
+  std::size_t const begin = text.find (prefix) + prefix.size ();
+  return text.substr (begin, text.rfind (suffix) - begin);
+}
+
+}  // end namespace details
+
+// type hash
+// ~~~~~~~~~
+/// Yields a 64-bit hash of the identity of T computed from the signature of a
+/// function template specialized for T. The hash of a type is the same in
+/// every translation unit built by a given compiler but may differ between
+/// compilers or compiler versions.
+template <typename T>
+struct type_hash
+    : std::integral_constant<std::uint64_t,
+                             details::fnv1a (details::signature<T> ())> {};
+template <typename T>
+inline constexpr std::uint64_t type_hash_v = type_hash<T>::value;
+
+// type name
+// ~~~~~~~~~
+/// The name of T as spelled by the compiler. The name refers to a string with
+/// static storage duration, so is usable at run time without a static
+/// initializer.
+template <typename T>
+inline constexpr std::string_view type_name_v = details::signature_name<T> ();
+
+/// A key operation for sort<> which yields the hash of a type.
+struct type_hash_key {
+  template <typename T>
+  using type = type_hash<T>;
+};
+
+// canonical
+// ~~~~~~~~~
+/// Yields the members of TypeList, each type appearing once, ordered by their
+/// type_hash. Two lists with the same members have the same canonical list
+/// regardless of the order or repetition of those members. (Distinct types
+/// with the same hash would be ordered as they first appear in the list.) The
+/// result has the same representation as TypeList.
+template <typename TypeList>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct canonical : sort<unique_t<TypeList>, type_hash_key> {};
+template <typename TypeList>
+using canonical_t = typename canonical<TypeList>::type;
+
+// set equal
+// ~~~~~~~~~
+/// Yields true if TypeList1 and TypeList2 have the same members, disregarding
+/// their order and any repeats. The canonical lists are compared as a single
+/// type rather than by searching one list for each member of the other.
+template <typename TypeList1, typename TypeList2>
+TYPE_LIST_CXX20REQUIRES ((is_type_list<TypeList1> && is_type_list<TypeList2>))
+struct set_equal : std::is_same<to_flat_t<canonical_t<TypeList1>>,
+                                to_flat_t<canonical_t<TypeList2>>> {};
+template <typename TypeList1, typename TypeList2>
+inline constexpr bool set_equal_v = set_equal<TypeList1, TypeList2>::value;
+
+}  // end namespace type_list
+
+#endif  // TYPE_HASH_HPP
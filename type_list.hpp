@@ -18,7 +18,11 @@
 #ifndef TYPE_LIST_HPP
 #define TYPE_LIST_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <type_traits>
+#include <utility>
 
 #if __cplusplus >= 202002L
 #define TYPE_LIST_CXX20REQUIRES(x) requires x
@@ -26,6 +30,59 @@
 #define TYPE_LIST_CXX20REQUIRES(x)
 #endif  // __cplusplus >= 202002L
 
+// Where the compiler provides it, the __is_same builtin compares two types
+// without instantiating anything.
+#if defined(__has_builtin)
+#if __has_builtin(__is_same)
+#define TYPE_LIST_IS_SAME(x, y) __is_same (x, y)
+#endif  // __has_builtin(__is_same)
+#endif  // defined(__has_builtin)
+#ifndef TYPE_LIST_IS_SAME
+#define TYPE_LIST_IS_SAME(x, y) std::is_same_v<x, y>
+#endif  // TYPE_LIST_IS_SAME
+
+// Likewise, the __is_base_of builtin checks for a base class without
+// instantiating std::is_base_of<>.
+#if defined(__has_builtin)
+#if __has_builtin(__is_base_of)
+#define TYPE_LIST_IS_BASE_OF(x, y) __is_base_of (x, y)
+#endif  // __has_builtin(__is_base_of)
+#endif  // defined(__has_builtin)
+#ifndef TYPE_LIST_IS_BASE_OF
+#define TYPE_LIST_IS_BASE_OF(x, y) std::is_base_of_v<x, y>
+#endif  // TYPE_LIST_IS_BASE_OF
+
+// Clang and GCC 14 or later provide __type_pack_element<I, T...> which yields
+// the I'th type of a pack without instantiating anything.
+#if defined(__has_builtin)
+#if __has_builtin(__type_pack_element)
+#define TYPE_LIST_HAS_TYPE_PACK_ELEMENT 1
+#endif  // __has_builtin(__type_pack_element)
+#endif  // defined(__has_builtin)
+#ifndef TYPE_LIST_HAS_TYPE_PACK_ELEMENT
+#define TYPE_LIST_HAS_TYPE_PACK_ELEMENT 0
+#endif  // TYPE_LIST_HAS_TYPE_PACK_ELEMENT
+
+// Clang and MSVC provide __make_integer_seq<Template, T, N> and GCC provides
+// __integer_pack(N). Either yields the integers 0 to N-1 without recursion.
+#if defined(__has_builtin)
+#if __has_builtin(__make_integer_seq)
+#define TYPE_LIST_HAS_MAKE_INTEGER_SEQ 1
+#endif  // __has_builtin(__make_integer_seq)
+#if __has_builtin(__integer_pack)
+#define TYPE_LIST_HAS_INTEGER_PACK 1
+#endif  // __has_builtin(__integer_pack)
+#endif  // defined(__has_builtin)
+#if !defined(TYPE_LIST_HAS_MAKE_INTEGER_SEQ) && defined(_MSC_VER)
+#define TYPE_LIST_HAS_MAKE_INTEGER_SEQ 1
+#endif  // !defined(TYPE_LIST_HAS_MAKE_INTEGER_SEQ) && defined(_MSC_VER)
+#ifndef TYPE_LIST_HAS_MAKE_INTEGER_SEQ
+#define TYPE_LIST_HAS_MAKE_INTEGER_SEQ 0
+#endif  // TYPE_LIST_HAS_MAKE_INTEGER_SEQ
+#ifndef TYPE_LIST_HAS_INTEGER_PACK
+#define TYPE_LIST_HAS_INTEGER_PACK 0
+#endif  // TYPE_LIST_HAS_INTEGER_PACK
+
 namespace type_list {
 
 template <typename... Types>
@@ -33,30 +90,46 @@ struct type_list;
 template <>
 struct type_list<> {};
 
+template <typename... Types>
+struct flat_list;
+template <>
+struct flat_list<> {};
+
+namespace details {
+
+/// The base of every lazy view (transform_view, filter_view and take_view).
+struct view_base {};
+
+}  // end namespace details
+
 #if __cplusplus >= 202002L
 // concepts
 // ~~~~~~~~
 /// An element in a type list must contain member types names 'first' and
-/// 'rest'. The end of the list is given by the type_list<> specialization.
+/// 'rest'. The end of the list is given by the type_list<> or flat_list<>
+/// specialization. A lazy view is also accepted.
 template <typename T>
 concept is_type_list = requires {
   typename T::first;
   typename T::rest;
 }
-|| std::is_same_v<T, type_list<>>;
+|| std::is_same_v<T, type_list<>> || std::is_same_v<T, flat_list<>> ||
+    std::is_base_of_v<details::view_base, T>;
 
 template <typename UnaryOperation, typename TypeList>
 concept is_unary_operation = requires (UnaryOperation&&) {
   typename UnaryOperation::template type<typename TypeList::first>;
 }
-|| std::is_same_v<TypeList, type_list<>>;
+|| std::is_same_v<TypeList, type_list<>> || std::is_same_v<TypeList, flat_list<>> ||
+    std::is_base_of_v<details::view_base, TypeList>;
 
 template <typename BinaryOperation, typename TypeList, typename InitialElement>
 concept is_binary_operation = requires (BinaryOperation&&, InitialElement&&) {
-  typename BinaryOperation::template type<InitialElement,
-                                          typename TypeList::first>;
+  typename BinaryOperation::template type<typename TypeList::first,
+                                          typename InitialElement::type>;
 }
-|| std::is_same_v<TypeList, type_list<>>;
+|| std::is_same_v<TypeList, type_list<>> || std::is_same_v<TypeList, flat_list<>> ||
+    std::is_base_of_v<details::view_base, TypeList>;
 #endif  // __cplusplus >= 202002L
 
 // type list
@@ -76,66 +149,915 @@ struct type_list<First, Rest> {
   using rest = Rest;
 };
 
+// flat list
+// ~~~~~~~~~
+/// An instance of flat_list holds all of the members of a list in a single
+/// template parameter pack. Unlike the chain of type_list cells, the whole list
+/// is one instantiation and algorithms may operate on it with pack expansions
+/// and fold expressions rather than by recursion. The 'first' and 'rest' members
+/// are provided so that a flat_list may be passed anywhere that a chain of
+/// type_list cells is expected.
+template <typename First, typename... Rest>
+struct flat_list<First, Rest...> {
+  using first = First;
+  using rest = flat_list<Rest...>;
+};
+
+namespace details {
+
+/// A tag type used to carry a type through a fold expression.
+template <typename T>
+struct element {};
+
+/// The accumulator used by make<> to build a chain of type_list cells from
+/// right to left.
+template <typename TypeList>
+struct cons_builder {
+  using type = TypeList;
+};
+template <typename T, typename TypeList>
+cons_builder<type_list<T, TypeList>> operator+ (element<T>,
+                                                cons_builder<TypeList>);
+
+template <typename FlatList, std::size_t Length>
+struct blocks;
+
+/// Gathers the members of a flat list into a tree and yields its root ('type')
+/// and the number of members held by each child of the root ('span'). The
+/// root has no more than Limit children and every other node has Fanout
+/// children (the last of a level may have fewer). When the span is 1 the
+/// children of a node are the members themselves; otherwise each child is a
+/// node whose own children hold span / Fanout members. A list of no more than
+/// Limit members is its own root.
+template <typename FlatList, std::size_t Fanout, std::size_t Limit = Fanout,
+          std::size_t Span = 1U>
+struct tree_root;
+template <typename Node, std::size_t Fanout, std::size_t Limit,
+          std::size_t Span, bool IsRoot>
+struct grow_tree {
+  using type = Node;
+  static constexpr std::size_t span = Span;
+};
+template <typename Node, std::size_t Fanout, std::size_t Limit,
+          std::size_t Span>
+struct grow_tree<Node, Fanout, Limit, Span, false>
+    : tree_root<typename blocks<Node, Fanout>::type, Fanout, Limit,
+                Span * Fanout> {};
+template <typename... Children, std::size_t Fanout, std::size_t Limit,
+          std::size_t Span>
+struct tree_root<flat_list<Children...>, Fanout, Limit, Span>
+    : grow_tree<flat_list<Children...>, Fanout, Limit, Span,
+                (sizeof...(Children) <= Limit)> {};
+
+/// Clang limits a fold expression to 256 operands (its default bracket
+/// depth). A longer pack is folded over the nodes of a tree whose root has no
+/// more than fold_limit children and whose other nodes have fold_fanout.
+inline constexpr std::size_t fold_limit = 256U;
+inline constexpr std::size_t fold_fanout = 64U;
+
+/// The tree over which the members of FlatList are folded.
+template <typename FlatList>
+using fold_tree = tree_root<FlatList, fold_fanout, fold_limit>;
+
+/// A tag type used to carry a node of a tree built by tree_root<> through a
+/// fold expression. Each child of Node holds Span members.
+template <std::size_t Span, typename Node>
+struct subtree {};
+
+/// Prepends the members below Node, a node whose children each hold Span
+/// members, to the chain of type_list cells TypeList.
+template <std::size_t Span, typename Node, typename TypeList>
+struct prepend_cells;
+template <typename... Types, typename TypeList>
+struct prepend_cells<1U, flat_list<Types...>, TypeList> {
+  using type = typename decltype ((element<Types>{} + ... +
+                                   cons_builder<TypeList>{}))::type;
+};
+template <std::size_t Span, typename... Children, typename TypeList>
+struct prepend_cells<Span, flat_list<Children...>, TypeList> {
+  using type =
+      typename decltype ((subtree<Span / fold_fanout, Children>{} + ... +
+                          cons_builder<TypeList>{}))::type;
+};
+template <std::size_t Span, typename Node, typename TypeList>
+cons_builder<typename prepend_cells<Span, Node, TypeList>::type> operator+ (
+    subtree<Span, Node>, cons_builder<TypeList>);
+
+/// Yields a chain of type_list cells whose members are Types followed by the
+/// members of the chain TypeList. The cells of TypeList are shared.
+template <typename TypeList, typename... Types>
+struct cons_of
+    : prepend_cells<fold_tree<flat_list<Types...>>::span,
+                    typename fold_tree<flat_list<Types...>>::type, TypeList> {};
+
+template <typename FlatList, typename... Types>
+struct prepend;
+template <typename... Members, typename... Types>
+struct prepend<flat_list<Members...>, Types...> {
+  using type = flat_list<Types..., Members...>;
+};
+
+}  // end namespace details
+
 // make
 // ~~~~
-/// Constructs a type_list from a template parameter pack.
+/// Constructs a type_list from a template parameter pack. The chain of cells is
+/// built by fold expressions over at most 256 types each, so the instantiation
+/// depth does not grow with the number of types.
+template <typename... Types>
+struct make : details::cons_of<type_list<>, Types...> {};
+template <typename... Types>
+using make_t = typename make<Types...>::type;
+
+/// Constructs a flat_list from a template parameter pack. Each cell of a chain
+/// names the rest of the chain, so the debug information for a chain of N
+/// cells holds O(N^2) characters of type names; a flat_list has a single name
+/// of O(N) characters.
+template <typename... Types>
+struct make_flat {
+  using type = flat_list<Types...>;
+};
 template <typename... Types>
-struct make;
+using make_flat_t = typename make_flat<Types...>::type;
+
+// to flat
+// ~~~~~~~
+/// Converts a type list to its flat_list equivalent. Chains of type_list cells
+/// are consumed eight cells per instantiation.
+template <typename TypeList>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct to_flat;
+template <typename... Types>
+struct to_flat<flat_list<Types...>> {
+  using type = flat_list<Types...>;
+};
+template <>
+struct to_flat<type_list<>> {
+  using type = flat_list<>;
+};
+template <typename First, typename Rest>
+struct to_flat<type_list<First, Rest>> {
+  using type =
+      typename details::prepend<typename to_flat<Rest>::type, First>::type;
+};
+template <typename T0, typename T1, typename T2, typename T3, typename T4,
+          typename T5, typename T6, typename T7, typename Rest>
+struct to_flat<type_list<
+    T0, type_list<T1, type_list<T2, type_list<T3, type_list<T4, type_list<
+        T5, type_list<T6, type_list<T7, Rest>>>>>>>>> {
+  using type = typename details::prepend<typename to_flat<Rest>::type, T0, T1,
+                                         T2, T3, T4, T5, T6, T7>::type;
+};
+template <typename TypeList>
+using to_flat_t = typename to_flat<TypeList>::type;
+
+// to cons
+// ~~~~~~~
+/// Converts a type list to the equivalent chain of type_list cells. A view is
+/// expanded by to_flat first.
+template <typename TypeList>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct to_cons : to_cons<to_flat_t<TypeList>> {};
 template <>
-struct make<> {
+struct to_cons<type_list<>> {
   using type = type_list<>;
 };
-template <typename T, typename... Ts>
-struct make<T, Ts...> {
-  using type = type_list<T, typename make<Ts...>::type>;
+template <typename First, typename Rest>
+struct to_cons<type_list<First, Rest>> {
+  using type = type_list<First, Rest>;
 };
 template <typename... Types>
-using make_t = typename make<Types...>::type;
+struct to_cons<flat_list<Types...>>
+    : details::cons_of<type_list<>, Types...> {};
+template <typename TypeList>
+using to_cons_t = typename to_cons<TypeList>::type;
+
+namespace details {
+
+/// Joins a sequence of flat lists. Eight lists are consumed by each
+/// instantiation: the pack of each list is expanded only once per instantiation
+/// rather than once for every list which follows it.
+template <typename... FlatLists>
+struct join;
+template <>
+struct join<> {
+  using type = flat_list<>;
+};
+template <typename... Types>
+struct join<flat_list<Types...>> {
+  using type = flat_list<Types...>;
+};
+template <typename... T0, typename... T1, typename... Rest>
+struct join<flat_list<T0...>, flat_list<T1...>, Rest...>
+    : join<flat_list<T0..., T1...>, Rest...> {};
+template <typename... T0, typename... T1, typename... T2, typename... T3,
+          typename... T4, typename... T5, typename... T6, typename... T7,
+          typename... Rest>
+struct join<flat_list<T0...>, flat_list<T1...>, flat_list<T2...>,
+            flat_list<T3...>, flat_list<T4...>, flat_list<T5...>,
+            flat_list<T6...>, flat_list<T7...>, Rest...>
+    : join<flat_list<T0..., T1..., T2..., T3..., T4..., T5..., T6..., T7...>,
+           Rest...> {};
+
+/// Joins the flat lists below Node, a node of a tree built by tree_root<>
+/// whose children each hold Span lists.
+template <std::size_t Span, typename Node>
+struct join_below;
+template <typename... FlatLists>
+struct join_below<1U, flat_list<FlatLists...>> : join<FlatLists...> {};
+template <std::size_t Span, typename... Children>
+struct join_below<Span, flat_list<Children...>>
+    : join<typename join_below<Span / fold_fanout, Children>::type...> {};
+
+/// Joins any number of flat lists. join<> consumes eight lists per
+/// instantiation, so a long sequence of lists is first gathered into a tree
+/// and the lists below each node are joined in turn: the instantiation depth
+/// grows with the logarithm of the number of lists rather than linearly.
+template <typename... FlatLists>
+struct join_all
+    : join_below<fold_tree<flat_list<FlatLists...>>::span,
+                 typename fold_tree<flat_list<FlatLists...>>::type> {};
+
+/// Yields FlatList in the representation used by Model: unchanged if Model is
+/// a flat_list, otherwise as a chain of type_list cells. A view uses the
+/// representation of the list underlying it.
+template <typename Model, typename FlatList>
+struct same_representation : to_cons<FlatList> {};
+template <typename... Types, typename FlatList>
+struct same_representation<flat_list<Types...>, FlatList> {
+  using type = FlatList;
+};
+
+}  // end namespace details
+
+// push front
+// ~~~~~~~~~~
+/// Yields a list whose members are Types followed by the members of TypeList.
+/// The result has the same representation as TypeList. The existing cells of a
+/// chain are shared rather than rebuilt. A view is first expanded to the
+/// representation of the list underlying it.
+template <typename TypeList, typename... Types>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct push_front
+    : push_front<typename details::same_representation<
+                     TypeList, to_flat_t<TypeList>>::type,
+                 Types...> {};
+template <typename... Types>
+struct push_front<type_list<>, Types...>
+    : details::cons_of<type_list<>, Types...> {};
+template <typename First, typename Rest, typename... Types>
+struct push_front<type_list<First, Rest>, Types...>
+    : details::cons_of<type_list<First, Rest>, Types...> {};
+template <typename... Members, typename... Types>
+struct push_front<flat_list<Members...>, Types...> {
+  using type = flat_list<Types..., Members...>;
+};
+template <typename TypeList, typename... Types>
+using push_front_t = typename push_front<TypeList, Types...>::type;
+
+// push back
+// ~~~~~~~~~
+/// Yields a list whose members are the members of TypeList followed by Types.
+/// The result has the same representation as TypeList.
+template <typename TypeList, typename... Types>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct push_back
+    : details::same_representation<
+          TypeList, typename push_back<to_flat_t<TypeList>, Types...>::type> {};
+template <typename... Members, typename... Types>
+struct push_back<flat_list<Members...>, Types...> {
+  using type = flat_list<Members..., Types...>;
+};
+template <typename TypeList, typename... Types>
+using push_back_t = typename push_back<TypeList, Types...>::type;
+
+// concat
+// ~~~~~~
+/// Yields a list whose members are the members of each of TypeLists in turn.
+/// Up to eight flat lists are joined by a single instantiation and many lists
+/// are joined through a tree, so the instantiation depth grows with the
+/// logarithm of the number of lists and does not depend on their length. The
+/// result has the same representation as the first list; concat<> yields
+/// make_t<>.
+template <typename... TypeLists>
+struct concat {
+  using type = make_t<>;
+};
+template <typename First, typename... Rest>
+struct concat<First, Rest...>
+    : details::same_representation<
+          First, typename details::join_all<to_flat_t<First>,
+                                            to_flat_t<Rest>...>::type> {};
+template <typename... TypeLists>
+using concat_t = typename concat<TypeLists...>::type;
+
+// generators
+// ~~~~~~~~~~
+namespace details {
+
+/// Yields Sequence followed by a copy of Sequence offset by its length and,
+/// if Odd is true, by one more index.
+template <typename Sequence, bool Odd>
+struct double_sequence;
+template <std::size_t... Indices>
+struct double_sequence<std::index_sequence<Indices...>, false> {
+  using type =
+      std::index_sequence<Indices..., (sizeof...(Indices) + Indices)...>;
+};
+template <std::size_t... Indices>
+struct double_sequence<std::index_sequence<Indices...>, true> {
+  using type =
+      std::index_sequence<Indices..., (sizeof...(Indices) + Indices)...,
+                          2U * sizeof...(Indices)>;
+};
+
+/// Yields std::index_sequence<0, ..., Count - 1> by repeatedly doubling a
+/// shorter sequence. The instantiation depth is O(log Count).
+template <std::size_t Count>
+struct doubling_index_pack
+    : double_sequence<typename doubling_index_pack<Count / 2U>::type,
+                      Count % 2U != 0U> {};
+template <>
+struct doubling_index_pack<0U> {
+  using type = std::index_sequence<>;
+};
+
+/// Yields std::index_sequence<0, ..., Count - 1> using a compiler builtin
+/// where one is available.
+template <std::size_t Count>
+struct index_pack {
+#if TYPE_LIST_HAS_MAKE_INTEGER_SEQ
+  using type = __make_integer_seq<std::integer_sequence, std::size_t, Count>;
+#elif TYPE_LIST_HAS_INTEGER_PACK
+  using type = std::index_sequence<__integer_pack (Count)...>;
+#else
+  using type = typename doubling_index_pack<Count>::type;
+#endif  // TYPE_LIST_HAS_MAKE_INTEGER_SEQ
+};
+template <std::size_t Count>
+using index_pack_t = typename index_pack<Count>::type;
+
+template <typename Sequence>
+struct iota_flat;
+template <std::size_t... Indices>
+struct iota_flat<std::index_sequence<Indices...>> {
+  using type = flat_list<std::integral_constant<std::size_t, Indices>...>;
+};
+
+template <typename T, std::size_t>
+using repeat_element = T;
+template <typename T, typename Sequence>
+struct repeat_flat;
+template <typename T, std::size_t... Indices>
+struct repeat_flat<T, std::index_sequence<Indices...>> {
+  using type = flat_list<repeat_element<T, Indices>...>;
+};
+
+}  // end namespace details
+
+/// Yields a flat_list of std::integral_constant<std::size_t, I> for each I
+/// from 0 to Count - 1. The indices are produced by __make_integer_seq or
+/// __integer_pack where the compiler provides one of them and otherwise by
+/// doubling, so building the list takes O(log Count) instantiations beside the
+/// members themselves.
+template <std::size_t Count>
+struct iota_list : details::iota_flat<details::index_pack_t<Count>> {};
+template <std::size_t Count>
+using iota_list_t = typename iota_list<Count>::type;
+
+/// Yields a flat_list in which T appears Count times.
+template <typename T, std::size_t Count>
+struct repeat : details::repeat_flat<T, details::index_pack_t<Count>> {};
+template <typename T, std::size_t Count>
+using repeat_t = typename repeat<T, Count>::type;
 
 // size
 // ~~~~
-/// Yields the number of elements in the list.
+/// Yields the number of elements in the list. A chain of type_list cells is
+/// first converted to a flat_list, which consumes eight cells per
+/// instantiation.
 template <typename TypeList>
 TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
-struct size
-    : std::integral_constant<size_t,
-                             1U + size<typename TypeList::rest>::value> {};
+struct size : size<to_flat_t<TypeList>> {};
 template <>
-struct size<type_list<>> : std::integral_constant<size_t, 0U> {};
+struct size<type_list<>> : std::integral_constant<std::size_t, 0U> {};
+template <typename... Types>
+struct size<flat_list<Types...>>
+    : std::integral_constant<std::size_t, sizeof...(Types)> {};
 
 template <typename TypeList>
-inline constexpr size_t size_v = size<TypeList>::value;
+inline constexpr std::size_t size_v = size<TypeList>::value;
+
+namespace details {
+
+/// Yields the index of the first of Flags which is true, or the number of
+/// flags if none is. The flags are copied to a local array: GCC copies the
+/// whole of a static array each time that one of its values is read during
+/// constant evaluation, which would make the scan quadratic. The other
+/// constexpr scans in this file keep their arrays local for the same reason.
+template <bool... Flags>
+constexpr std::size_t first_true () {
+  bool const flags[] = {Flags..., true};
+  std::size_t index = 0;
+  while (!flags[index]) {
+    ++index;
+  }
+  return index;
+}
+
+/// Yields Index plus the index of the first of Types for which UnaryPredicate
+/// holds, or Index + sizeof...(Types) if there is no such member.
+template <typename UnaryPredicate, std::size_t Index, typename... Types>
+struct find_leaf
+    : std::integral_constant<
+          std::size_t,
+          Index + first_true<static_cast<bool> (
+                      UnaryPredicate::template type<Types>::value)...> ()> {};
+
+/// A predicate which holds for the type Element. find_leaf<> compares the
+/// members with TYPE_LIST_IS_SAME rather than instantiating the predicate.
+template <typename Element>
+struct same_as {
+  template <typename T>
+  using type = std::is_same<Element, T>;
+};
+template <typename Element, std::size_t Index, typename... Types>
+struct find_leaf<same_as<Element>, Index, Types...>
+    : std::integral_constant<
+          std::size_t,
+          Index + first_true<TYPE_LIST_IS_SAME (Element, Types)...> ()> {};
+
+/// Yields Index plus the index of the first member of FlatList for which
+/// UnaryPredicate holds, or Index plus the size of the list if there is none.
+/// The first Groups groups of 8 members are peeled off and examined in turn so
+/// that an early match does not apply the predicate to the rest of the list.
+/// The members which remain are examined by a single find_leaf<>: gathering
+/// them into groups would cost more instantiations than the predicate itself.
+template <typename UnaryPredicate, std::size_t Index, std::size_t Groups,
+          typename FlatList,
+          bool IsPeeled = (Groups > 0U && size_v<FlatList> > 8U)>
+struct find_flat;
+template <typename UnaryPredicate, std::size_t Index, std::size_t Groups,
+          typename... Types>
+struct find_flat<UnaryPredicate, Index, Groups, flat_list<Types...>, false>
+    : std::integral_constant<
+          std::size_t, find_leaf<UnaryPredicate, Index, Types...>::value> {};
+template <typename UnaryPredicate, std::size_t Index, std::size_t Groups,
+          typename T0, typename T1, typename T2, typename T3, typename T4,
+          typename T5, typename T6, typename T7, typename... Rest>
+struct find_flat<UnaryPredicate, Index, Groups,
+                 flat_list<T0, T1, T2, T3, T4, T5, T6, T7, Rest...>, true>
+    : std::conditional_t<
+          (find_leaf<UnaryPredicate, Index, T0, T1, T2, T3, T4, T5, T6,
+                     T7>::value < Index + 8U),
+          std::integral_constant<
+              std::size_t, find_leaf<UnaryPredicate, Index, T0, T1, T2, T3,
+                                     T4, T5, T6, T7>::value>,
+          find_flat<UnaryPredicate, Index + 8U, Groups - 1U,
+                    flat_list<Rest...>>> {};
+
+/// Returns true if T is one of Types. The comparisons are gathered in an array
+/// rather than a fold expression, which Clang limits to 256 operands.
+template <typename T, typename... Types>
+constexpr bool is_one_of () {
+  bool const same[] = {TYPE_LIST_IS_SAME (T, Types)..., false};
+  for (bool const s : same) {
+    if (s) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// The result of a search of a chain of type_list cells which matched the
+/// member at Index.
+template <std::size_t Index>
+struct found_at : std::integral_constant<std::size_t, Index> {
+  static constexpr bool found = true;
+};
+
+/// Yields Index plus the index of the first member of a chain of type_list
+/// cells for which UnaryPredicate holds, or Index plus the length of the chain
+/// if there is none; 'found' is true if there is a match. Like find_flat<>,
+/// the first Groups groups of 8 cells are examined in turn. The cells which
+/// remain are converted by to_flat, which consumes eight cells per
+/// instantiation, and examined by a single find_leaf<>.
+template <typename UnaryPredicate, std::size_t Index, std::size_t Groups,
+          typename TypeList, bool IsPeeled = (Groups > 0U)>
+struct find_cons
+    : find_flat<UnaryPredicate, Index, 0U, to_flat_t<TypeList>> {
+  static constexpr bool found =
+      find_cons::value < Index + size_v<to_flat_t<TypeList>>;
+};
+template <typename UnaryPredicate, std::size_t Index, std::size_t Groups,
+          typename T0, typename T1, typename T2, typename T3, typename T4,
+          typename T5, typename T6, typename T7, typename Rest>
+struct find_cons<
+    UnaryPredicate, Index, Groups,
+    type_list<T0, type_list<T1, type_list<T2, type_list<T3, type_list<T4,
+        type_list<T5, type_list<T6, type_list<T7, Rest>>>>>>>>,
+    true>
+    : std::conditional_t<
+          (find_leaf<UnaryPredicate, Index, T0, T1, T2, T3, T4, T5, T6,
+                     T7>::value < Index + 8U),
+          found_at<find_leaf<UnaryPredicate, Index, T0, T1, T2, T3, T4, T5,
+                             T6, T7>::value>,
+          find_cons<UnaryPredicate, Index + 8U, Groups - 1U, Rest>> {};
+
+template <typename UnaryPredicate>
+struct negate {
+  template <typename T>
+  using type = std::negation<typename UnaryPredicate::template type<T>>;
+};
+
+}  // end namespace details
+
+// at
+// ~~
+namespace details {
+
+/// A class which derives from indexed<I, T> for each member T at index I of a
+/// list. select<I>() picks out a member by overload resolution against the
+/// bases of this class so that no recursion is needed.
+template <std::size_t Index, typename T>
+struct indexed {
+  using type = T;
+};
+template <typename Sequence, typename... Types>
+struct indexer;
+template <std::size_t... Indices, typename... Types>
+struct indexer<std::index_sequence<Indices...>, Types...>
+    : indexed<Indices, Types>... {};
+
+template <std::size_t Index, typename T>
+indexed<Index, T> select (indexed<Index, T> const*);
+
+}  // end namespace details
+
+/// Yields the member of the list at position Index. A chain of type_list cells
+/// is first converted to a flat_list; the member of a flat_list is found by
+/// the __type_pack_element builtin where it is available and otherwise by
+/// overload resolution against a class derived from every member.
+template <typename TypeList, std::size_t Index>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct at : at<to_flat_t<TypeList>, Index> {};
+template <typename... Types, std::size_t Index>
+struct at<flat_list<Types...>, Index> {
+  static_assert (Index < sizeof...(Types), "at<> index is out of range");
+#if TYPE_LIST_HAS_TYPE_PACK_ELEMENT
+  using type = __type_pack_element<Index, Types...>;
+#else
+  using type = typename decltype (details::select<Index> (
+      static_cast<details::indexer<std::index_sequence_for<Types...>,
+                                   Types...> const*> (nullptr)))::type;
+#endif  // TYPE_LIST_HAS_TYPE_PACK_ELEMENT
+};
+
+template <typename TypeList, std::size_t Index>
+using at_t = typename at<TypeList, Index>::type;
+
+namespace details {
+
+constexpr std::size_t clamp_count (std::size_t count, std::size_t size) {
+  return count < size ? count : size;
+}
+
+template <std::size_t Offset, typename Sequence>
+struct offset_sequence;
+template <std::size_t Offset, std::size_t... Indices>
+struct offset_sequence<Offset, std::index_sequence<Indices...>> {
+  using type = std::index_sequence<(Offset + Indices)...>;
+};
+
+/// Yields the indexer for the members of a flat list.
+template <typename FlatList>
+struct table_of;
+template <typename... Types>
+struct table_of<flat_list<Types...>> {
+  using type = indexer<std::index_sequence_for<Types...>, Types...>;
+};
+
+/// Moves the members of a list Distance places towards its front: the first
+/// Distance members are dropped and as many empty lists are appended. The
+/// dropped members are matched by the leading void const* parameters, so the
+/// shift is a single deduction rather than a recursion.
+template <std::size_t Distance,
+          typename Skipped = index_pack_t<Distance>>
+struct shifter;
+template <std::size_t Distance, std::size_t... Skipped>
+struct shifter<Distance, std::index_sequence<Skipped...>> {
+  template <typename... Rest>
+  static flat_list<Rest..., repeat_element<flat_list<>, Skipped>...> shift (
+      repeat_element<void const*, Skipped>..., element<Rest>*...);
+};
+template <std::size_t Distance, typename... Slots>
+using shifted =
+    decltype (shifter<clamp_count (Distance, sizeof...(Slots))>::shift (
+        static_cast<element<Slots>*> (nullptr)...));
+
+/// A slot of a gather holds either a flat list or a gather_step<> which has
+/// not yet been instantiated. slot_value<> yields the flat list in either
+/// case.
+template <typename Slot>
+struct slot_value {
+  using type = Slot;
+};
+template <bool IsLeader, typename... Slots>
+struct gather_step;
+template <typename... Slots>
+struct gather_step<true, Slots...>
+    : join<typename slot_value<Slots>::type...> {};
+template <bool IsLeader, typename... Slots>
+struct slot_value<gather_step<IsLeader, Slots...>>
+    : gather_step<IsLeader, Slots...> {};
+
+constexpr bool is_leader (std::size_t index, std::size_t distance) {
+  return index % (8U * distance) == 0U;
+}
+template <std::size_t Distance, typename Sequence>
+struct leaders;
+template <std::size_t Distance, std::size_t... Indices>
+struct leaders<Distance, std::index_sequence<Indices...>> {
+  using type = std::integer_sequence<bool, is_leader (Indices, Distance)...>;
+};
+
+/// One round of a gather: slot I becomes the slots I, I + Distance, ...,
+/// I + 7 * Distance of the previous round. Only the leaders (every 8 *
+/// Distance'th slot) are ever instantiated; the other slots are named but
+/// never used.
+template <typename Leaders, typename... Shifted>
+struct gather_round;
+template <bool... Leaders, typename... S0, typename... S1, typename... S2,
+          typename... S3, typename... S4, typename... S5, typename... S6,
+          typename... S7>
+struct gather_round<std::integer_sequence<bool, Leaders...>, flat_list<S0...>,
+                    flat_list<S1...>, flat_list<S2...>, flat_list<S3...>,
+                    flat_list<S4...>, flat_list<S5...>, flat_list<S6...>,
+                    flat_list<S7...>> {
+  using type =
+      flat_list<gather_step<Leaders, S0, S1, S2, S3, S4, S5, S6, S7>...>;
+};
+
+/// Gathers the slots until slot I * Length holds members [I * Length, (I + 1)
+/// * Length) of the original list. Each round multiplies the length of the
+/// leading slots by 8, so there are log8(Length) rounds.
+template <std::size_t Length, std::size_t Distance, typename Slots,
+          bool IsDone = (Distance >= Length)>
+struct gather_rounds {
+  using type = Slots;
+};
+template <std::size_t Length, std::size_t Distance, typename... Slots>
+struct gather_rounds<Length, Distance, flat_list<Slots...>, false>
+    : gather_rounds<
+          Length, Distance * 8U,
+          typename gather_round<
+              typename leaders<Distance,
+                               std::index_sequence_for<Slots...>>::type,
+              flat_list<Slots...>, shifted<Distance, Slots...>,
+              shifted<2U * Distance, Slots...>,
+              shifted<3U * Distance, Slots...>,
+              shifted<4U * Distance, Slots...>,
+              shifted<5U * Distance, Slots...>,
+              shifted<6U * Distance, Slots...>,
+              shifted<7U * Distance, Slots...>>::type> {};
+
+template <std::size_t Stride, typename Sequence>
+struct strided_sequence;
+template <std::size_t Stride, std::size_t... Indices>
+struct strided_sequence<Stride, std::index_sequence<Indices...>> {
+  using type = std::index_sequence<(Indices * Stride)...>;
+};
+
+/// Yields the member T of each base indexed<P, T> of Table for each P of
+/// Positions in turn. Each member costs a search of the bases of Table. The
+/// table is a template argument rather than a member type: GCC is far slower
+/// to expand a pack which names a member of the class being instantiated.
+template <typename Table, typename Positions>
+struct select_each;
+template <typename Table, std::size_t... Positions>
+struct select_each<Table, std::index_sequence<Positions...>> {
+  using type = flat_list<typename decltype (details::select<Positions> (
+      static_cast<Table const*> (nullptr)))::type...>;
+};
+
+template <typename FlatList>
+struct slot_values;
+template <typename... Slots>
+struct slot_values<flat_list<Slots...>> {
+  using type = flat_list<typename slot_value<Slots>::type...>;
+};
+
+/// Yields a flat_list whose members are flat lists holding consecutive runs of
+/// Length members of FlatList; the last may be shorter.
+template <typename FlatList, std::size_t Length>
+struct blocks;
+template <typename... Types, std::size_t Length>
+struct blocks<flat_list<Types...>, Length>
+    : slot_values<typename select_each<
+          typename table_of<typename gather_rounds<
+              Length, 1U, flat_list<flat_list<Types>...>>::type>::type,
+          typename strided_sequence<
+              Length, index_pack_t<(sizeof...(Types) + Length - 1U) /
+                                   Length>>::type>::type> {};
+
+/// The length of the blocks used to pick from a list of Count members: the
+/// power of 8 which minimizes the cost of the two searches for each member (of
+/// the Count / Length blocks and then of the Length members of a block).
+constexpr std::size_t block_length (std::size_t count) {
+  std::size_t length = 8U;
+  while (2U * count / length + length >
+         2U * count / (8U * length) + 8U * length) {
+    length *= 8U;
+  }
+  return length;
+}
+
+/// An indexer whose bases are the indexers of each of a list of blocks.
+template <typename Blocks>
+struct blocks_table;
+template <typename... Blocks>
+struct blocks_table<flat_list<Blocks...>> {
+  using type = indexer<std::index_sequence_for<Blocks...>,
+                       typename table_of<Blocks>::type...>;
+};
+
+/// Picks each member by two searches of short indexers: first, of Table for
+/// the block holding the position, and then of that block.
+template <typename Table, std::size_t Length, typename Positions>
+struct pick_blocks;
+template <typename Table, std::size_t Length, std::size_t... Positions>
+struct pick_blocks<Table, Length, std::index_sequence<Positions...>> {
+  using type = flat_list<
+      typename decltype (details::select<Positions % Length> (
+          static_cast<typename decltype (details::select<Positions / Length> (
+              static_cast<Table const*> (nullptr)))::type const*> (
+              nullptr)))::type...>;
+};
+
+/// The indexer from which the members of FlatList are picked by pick_table<>
+/// and the length of its blocks. A length of 0 means that the indexer holds
+/// the members themselves rather than blocks of them.
+template <typename FlatList, bool IsDirect = (size_v<FlatList> <= 64U)>
+struct shared_table {
+  static constexpr std::size_t length = 0U;
+  using type = typename table_of<FlatList>::type;
+};
+template <typename... Types>
+struct shared_table<flat_list<Types...>, false> {
+  static constexpr std::size_t length = block_length (sizeof...(Types));
+  using type = typename blocks_table<
+      typename blocks<flat_list<Types...>, length>::type>::type;
+};
+
+/// Picks the members at Positions from an indexer built by shared_table<>.
+/// Many picks from the same list should each name the table rather than the
+/// list: the table is built once and is far cheaper to pass around.
+template <typename Table, std::size_t Length, typename Positions>
+struct pick_table : pick_blocks<Table, Length, Positions> {};
+template <typename Table, typename Positions>
+struct pick_table<Table, 0U, Positions> : select_each<Table, Positions> {};
+
+template <typename FlatList, typename Positions, bool IsDirect,
+          typename Table = shared_table<FlatList, IsDirect>>
+struct pick_impl
+    : pick_table<typename Table::type, Table::length, Positions> {};
+
+/// Yields a flat_list of the members of FlatList at each of Positions in turn.
+/// Where __type_pack_element is available, it picks out each member directly.
+/// Otherwise, a short list (or a handful of positions) is picked from a single
+/// indexer. A longer list is first gathered into blocks, so that each member is
+/// found by searching the blocks and then one block rather than the whole
+/// list. Picking from the whole list would cost time proportional to the
+/// product of the lengths of the list and of the result.
+template <typename FlatList, typename Positions>
+struct pick;
+template <typename... Types, std::size_t... Positions>
+struct pick<flat_list<Types...>, std::index_sequence<Positions...>> {
+#if TYPE_LIST_HAS_TYPE_PACK_ELEMENT
+  using type = flat_list<__type_pack_element<Positions, Types...>...>;
+#else
+  using type = typename pick_impl<
+      flat_list<Types...>, std::index_sequence<Positions...>,
+      (sizeof...(Types) <= 64U || sizeof...(Positions) <= 8U)>::type;
+#endif  // TYPE_LIST_HAS_TYPE_PACK_ELEMENT
+};
+
+}  // end namespace details
 
 // contains
 // ~~~~~~~~
 /// Yields true if the type list contains a type matching Element and false
-/// otherwise.
+/// otherwise. The first 64 cells of a chain are examined in groups of 8 and no
+/// group after the first match is instantiated; the rest of the chain is
+/// converted by to_flat. A view is expanded by to_flat before it is searched.
 template <typename TypeList, typename Element>
 TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
-struct contains
-    : std::bool_constant<std::is_same_v<Element, typename TypeList::first> ||
-                         contains<typename TypeList::rest, Element>::value> {};
-template <typename Element>
-struct contains<type_list<>, Element> : std::bool_constant<false> {};
+struct contains : contains<to_flat_t<TypeList>, Element> {};
+template <typename First, typename Rest, typename Element>
+struct contains<type_list<First, Rest>, Element>
+    : std::bool_constant<details::find_cons<details::same_as<Element>, 0U, 8U,
+                                            type_list<First, Rest>>::found> {};
+template <typename... Types, typename Element>
+struct contains<flat_list<Types...>, Element>
+    : std::bool_constant<details::is_one_of<Element, Types...> ()> {};
 
 template <typename TypeList, typename Element>
 inline constexpr bool contains_v = contains<TypeList, Element>::value;
 
+// find
+// ~~~~
+/// Yields the index of the first member of the list for which
+/// UnaryPredicate::type<T>::value is true, or the size of the list if there is
+/// no such member. The members are examined in groups of 8 and the predicate
+/// is not applied to any group after the one holding the first match. Beyond
+/// the first 64 members, the rest of the list is examined at once.
+template <typename TypeList, typename UnaryPredicate>
+TYPE_LIST_CXX20REQUIRES ((is_type_list<TypeList> &&
+                          is_unary_operation<UnaryPredicate, TypeList>))
+struct find : find<to_flat_t<TypeList>, UnaryPredicate> {};
+template <typename First, typename Rest, typename UnaryPredicate>
+struct find<type_list<First, Rest>, UnaryPredicate>
+    : details::find_cons<UnaryPredicate, 0U, 8U, type_list<First, Rest>> {};
+template <typename... Types, typename UnaryPredicate>
+struct find<flat_list<Types...>, UnaryPredicate>
+    : details::find_flat<UnaryPredicate, 0U, 8U, flat_list<Types...>> {};
+
+template <typename TypeList, typename UnaryPredicate>
+inline constexpr std::size_t find_v = find<TypeList, UnaryPredicate>::value;
+
+// index of
+// ~~~~~~~~
+/// Yields the index of the first member of the list matching Element, or the
+/// size of the list if there is no such member.
+template <typename TypeList, typename Element>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct index_of : index_of<to_flat_t<TypeList>, Element> {};
+template <typename First, typename Rest, typename Element>
+struct index_of<type_list<First, Rest>, Element>
+    : details::find_cons<details::same_as<Element>, 0U, 8U,
+                         type_list<First, Rest>> {};
+template <typename... Types, typename Element>
+struct index_of<flat_list<Types...>, Element>
+    : std::integral_constant<
+          std::size_t,
+          details::first_true<TYPE_LIST_IS_SAME (Element, Types)...> ()> {};
+
+template <typename TypeList, typename Element>
+inline constexpr std::size_t index_of_v = index_of<TypeList, Element>::value;
+
+// any of
+// ~~~~~~
+/// Yields true if UnaryPredicate holds for at least one member of the list.
+/// The members are examined as they are by find<>.
+template <typename TypeList, typename UnaryPredicate>
+TYPE_LIST_CXX20REQUIRES ((is_type_list<TypeList> &&
+                          is_unary_operation<UnaryPredicate, TypeList>))
+struct any_of : any_of<to_flat_t<TypeList>, UnaryPredicate> {};
+template <typename First, typename Rest, typename UnaryPredicate>
+struct any_of<type_list<First, Rest>, UnaryPredicate>
+    : std::bool_constant<details::find_cons<UnaryPredicate, 0U, 8U,
+                                            type_list<First, Rest>>::found> {};
+template <typename... Types, typename UnaryPredicate>
+struct any_of<flat_list<Types...>, UnaryPredicate>
+    : std::bool_constant<(find<flat_list<Types...>, UnaryPredicate>::value <
+                          sizeof...(Types))> {};
+
+template <typename TypeList, typename UnaryPredicate>
+inline constexpr bool any_of_v = any_of<TypeList, UnaryPredicate>::value;
+
+// all of
+// ~~~~~~
+/// Yields true if UnaryPredicate holds for every member of the list.
+/// Evaluation stops at the first member for which the predicate does not hold.
+template <typename TypeList, typename UnaryPredicate>
+TYPE_LIST_CXX20REQUIRES ((is_type_list<TypeList> &&
+                          is_unary_operation<UnaryPredicate, TypeList>))
+struct all_of
+    : std::negation<any_of<TypeList, details::negate<UnaryPredicate>>> {};
+
+template <typename TypeList, typename UnaryPredicate>
+inline constexpr bool all_of_v = all_of<TypeList, UnaryPredicate>::value;
+
+// none of
+// ~~~~~~~
+/// Yields true if UnaryPredicate holds for no member of the list. Evaluation
+/// stops at the first member for which the predicate holds.
+template <typename TypeList, typename UnaryPredicate>
+TYPE_LIST_CXX20REQUIRES ((is_type_list<TypeList> &&
+                          is_unary_operation<UnaryPredicate, TypeList>))
+struct none_of : std::negation<any_of<TypeList, UnaryPredicate>> {};
+
+template <typename TypeList, typename UnaryPredicate>
+inline constexpr bool none_of_v = none_of<TypeList, UnaryPredicate>::value;
+
 // equal
 // ~~~~~
+/// Yields true if the two lists have the same members in the same order. The
+/// lists need not share a representation: a chain of type_list cells is equal
+/// to a flat_list with the same members.
 template <typename TypeList1, typename TypeList2>
 TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList1>&& is_type_list<TypeList2>)
-struct equal
-    : std::bool_constant<
-          std::is_same_v<typename TypeList1::first,
-                         typename TypeList2::first> &&
-          equal<typename TypeList1::rest, typename TypeList2::rest>::value> {};
-template <typename TypeList1>
-struct equal<TypeList1, type_list<>> : std::false_type {};
-template <typename TypeList2>
-struct equal<type_list<>, TypeList2> : std::false_type {};
-template <>
-struct equal<type_list<>, type_list<>> : std::true_type {};
+struct equal : std::is_same<to_flat_t<TypeList1>, to_flat_t<TypeList2>> {};
 
 template <typename TypeList1, typename TypeList2>
 inline constexpr bool equal_v = equal<TypeList1, TypeList2>::value;
@@ -147,23 +1069,39 @@ inline constexpr bool equal_v = equal<TypeList1, TypeList2>::value;
 template <typename TypeList, typename UnaryOperation>
 TYPE_LIST_CXX20REQUIRES ((is_type_list<TypeList> &&
                           is_unary_operation<UnaryOperation, TypeList>))
-struct transform {
-  using type = type_list<
-      typename UnaryOperation::template type<typename TypeList::first>::type,
-      typename transform<typename TypeList::rest, UnaryOperation>::type>;
-};
+struct transform : transform<to_flat_t<TypeList>, UnaryOperation> {};
 template <typename Operation>
 struct transform<type_list<>, Operation> {
   using type = type_list<>;
 };
+template <typename First, typename Rest, typename Operation>
+struct transform<type_list<First, Rest>, Operation>
+    : to_cons<typename transform<to_flat_t<type_list<First, Rest>>,
+                                 Operation>::type> {};
+template <typename... Types, typename Operation>
+struct transform<flat_list<Types...>, Operation> {
+  using type =
+      flat_list<typename Operation::template type<Types>::type...>;
+};
 template <typename TypeList, typename Operation>
 using transform_t = typename transform<TypeList, Operation>::type;
 
+namespace details {
+
+/// Combines a member T with the accumulated value Value in the manner of foldl
+/// and foldr.
+template <typename BinaryOperation, typename T, typename Value>
+using fold_step = typename BinaryOperation::template type<T, typename Value::type>;
+
+}  // end namespace details
+
 // fold left
 // ~~~~~~~~~
 /// If the list if empty, the result is the initial value; else we recurse,
 /// making the new initial value the result of combining the old initial value
-/// with the first element.
+/// with the first element. A chain of type_list cells is consumed eight cells
+/// per instantiation; a flat_list is folded by fold expressions over at most
+/// 256 members each.
 template <typename TypeList, typename BinaryOperation, typename Initial>
 TYPE_LIST_CXX20REQUIRES (
     (is_type_list<TypeList> &&
@@ -178,6 +1116,1118 @@ template <typename BinaryOperation, typename InitialValue>
 struct foldl<type_list<>, BinaryOperation, InitialValue> {
   using type = InitialValue;
 };
+template <typename T0, typename T1, typename T2, typename T3, typename T4,
+          typename T5, typename T6, typename T7, typename Rest,
+          typename BinaryOperation, typename InitialValue>
+struct foldl<type_list<T0, type_list<T1, type_list<T2, type_list<T3, type_list<
+                 T4, type_list<T5, type_list<T6, type_list<T7, Rest>>>>>>>>,
+             BinaryOperation, InitialValue> {
+private:
+  template <typename T, typename Value>
+  using step = details::fold_step<BinaryOperation, T, Value>;
+
+public:
+  using type = typename foldl<
+      Rest, BinaryOperation,
+      step<T7, step<T6, step<T5, step<T4, step<T3, step<T2, step<T1, step<T0,
+          InitialValue>>>>>>>>>::type;
+};
+
+namespace details {
+
+/// The accumulator of a left fold over a flat_list.
+template <typename BinaryOperation, typename Value>
+struct fold_state {
+  using type = Value;
+};
+template <typename BinaryOperation, typename Value, typename T>
+fold_state<BinaryOperation, fold_step<BinaryOperation, T, Value>> operator| (
+    fold_state<BinaryOperation, Value>, element<T>);
+
+/// Folds the members below Node, a node whose children each hold Span members,
+/// into Value from the left.
+template <std::size_t Span, typename Node, typename BinaryOperation,
+          typename Value>
+struct foldl_node;
+template <typename... Types, typename BinaryOperation, typename Value>
+struct foldl_node<1U, flat_list<Types...>, BinaryOperation, Value> {
+  using type = typename decltype ((fold_state<BinaryOperation, Value>{} | ... |
+                                   element<Types>{}))::type;
+};
+template <std::size_t Span, typename... Children, typename BinaryOperation,
+          typename Value>
+struct foldl_node<Span, flat_list<Children...>, BinaryOperation, Value> {
+  using type = typename decltype ((
+      fold_state<BinaryOperation, Value>{} | ... |
+      subtree<Span / fold_fanout, Children>{}))::type;
+};
+template <typename BinaryOperation, typename Value, std::size_t Span,
+          typename Node>
+fold_state<BinaryOperation,
+           typename foldl_node<Span, Node, BinaryOperation, Value>::type>
+operator| (fold_state<BinaryOperation, Value>, subtree<Span, Node>);
+
+}  // end namespace details
+
+template <typename... Types, typename BinaryOperation, typename InitialValue>
+struct foldl<flat_list<Types...>, BinaryOperation, InitialValue>
+    : details::foldl_node<
+          details::fold_tree<flat_list<Types...>>::span,
+          typename details::fold_tree<flat_list<Types...>>::type,
+          BinaryOperation, InitialValue> {};
+
+template <typename TypeList, typename BinaryOperation, typename Initial>
+using foldl_t = typename foldl<TypeList, BinaryOperation, Initial>::type;
+
+// fold right
+// ~~~~~~~~~~
+/// If the list is empty, the result is the initial value; else the result is
+/// the first element combined with the right fold of the rest of the list. As
+/// for foldl, BinaryOperation::type<> is given the member followed by the
+/// accumulated value and a chain of type_list cells is consumed eight cells per
+/// instantiation.
+template <typename TypeList, typename BinaryOperation, typename Initial>
+TYPE_LIST_CXX20REQUIRES (
+    (is_type_list<TypeList> &&
+     is_binary_operation<BinaryOperation, TypeList, Initial>))
+struct foldr : foldr<to_flat_t<TypeList>, BinaryOperation, Initial> {};
+template <typename BinaryOperation, typename InitialValue>
+struct foldr<type_list<>, BinaryOperation, InitialValue> {
+  using type = InitialValue;
+};
+template <typename First, typename Rest, typename BinaryOperation,
+          typename InitialValue>
+struct foldr<type_list<First, Rest>, BinaryOperation, InitialValue> {
+  using type = details::fold_step<
+      BinaryOperation, First,
+      typename foldr<Rest, BinaryOperation, InitialValue>::type>;
+};
+template <typename T0, typename T1, typename T2, typename T3, typename T4,
+          typename T5, typename T6, typename T7, typename Rest,
+          typename BinaryOperation, typename InitialValue>
+struct foldr<type_list<T0, type_list<T1, type_list<T2, type_list<T3, type_list<
+                 T4, type_list<T5, type_list<T6, type_list<T7, Rest>>>>>>>>,
+             BinaryOperation, InitialValue> {
+private:
+  template <typename T, typename Value>
+  using step = details::fold_step<BinaryOperation, T, Value>;
+
+public:
+  using type = step<
+      T0, step<T1, step<T2, step<T3, step<T4, step<T5, step<T6, step<T7,
+          typename foldr<Rest, BinaryOperation, InitialValue>::type>>>>>>>>;
+};
+
+namespace details {
+
+/// The accumulator of a right fold over a flat_list.
+template <typename BinaryOperation, typename Value>
+struct foldr_state {
+  using type = Value;
+};
+template <typename BinaryOperation, typename Value, typename T>
+foldr_state<BinaryOperation, fold_step<BinaryOperation, T, Value>> operator| (
+    element<T>, foldr_state<BinaryOperation, Value>);
+
+/// Folds the members below Node, a node whose children each hold Span members,
+/// into Value from the right.
+template <std::size_t Span, typename Node, typename BinaryOperation,
+          typename Value>
+struct foldr_node;
+template <typename... Types, typename BinaryOperation, typename Value>
+struct foldr_node<1U, flat_list<Types...>, BinaryOperation, Value> {
+  using type = typename decltype ((
+      element<Types>{} | ... | foldr_state<BinaryOperation, Value>{}))::type;
+};
+template <std::size_t Span, typename... Children, typename BinaryOperation,
+          typename Value>
+struct foldr_node<Span, flat_list<Children...>, BinaryOperation, Value> {
+  using type = typename decltype ((
+      subtree<Span / fold_fanout, Children>{} | ... |
+      foldr_state<BinaryOperation, Value>{}))::type;
+};
+template <typename BinaryOperation, typename Value, std::size_t Span,
+          typename Node>
+foldr_state<BinaryOperation,
+            typename foldr_node<Span, Node, BinaryOperation, Value>::type>
+operator| (subtree<Span, Node>, foldr_state<BinaryOperation, Value>);
+
+}  // end namespace details
+
+template <typename... Types, typename BinaryOperation, typename InitialValue>
+struct foldr<flat_list<Types...>, BinaryOperation, InitialValue>
+    : details::foldr_node<
+          details::fold_tree<flat_list<Types...>>::span,
+          typename details::fold_tree<flat_list<Types...>>::type,
+          BinaryOperation, InitialValue> {};
+
+template <typename TypeList, typename BinaryOperation, typename Initial>
+using foldr_t = typename foldr<TypeList, BinaryOperation, Initial>::type;
+
+// reduce
+// ~~~~~~
+namespace details {
+
+/// Yields the combination of members [Begin, End) of a non-empty range of a
+/// list whose members are picked from Table, an indexer built by
+/// shared_table<>. Later members are passed as the first argument of
+/// BinaryOperation::type<> so that, for an associative operation, the result
+/// is the same as the equivalent part of foldl. Ranges of more than 8 members
+/// are split in half, so the instantiation depth is logarithmic in the length
+/// of the list. The ranges name the table rather than the list, and the
+/// members of each leaf are picked from it together.
+template <typename BinaryOperation, typename Table, std::size_t Length,
+          std::size_t Begin, std::size_t End,
+          bool IsLeaf = (End - Begin <= 8U)>
+struct reduce_range;
+
+template <typename BinaryOperation, typename FlatList>
+struct reduce_leaf;
+template <typename BinaryOperation, typename First, typename... Rest>
+struct reduce_leaf<BinaryOperation, flat_list<First, Rest...>>
+    : foldl<flat_list<Rest...>, BinaryOperation, First> {};
+
+template <typename BinaryOperation, typename Table, std::size_t Length,
+          std::size_t Begin, std::size_t End>
+struct reduce_range<BinaryOperation, Table, Length, Begin, End, true>
+    : reduce_leaf<BinaryOperation,
+                  typename pick_table<
+                      Table, Length,
+                      typename offset_sequence<
+                          Begin, index_pack_t<End - Begin>>::type>::type> {};
+template <typename BinaryOperation, typename Table, std::size_t Length,
+          std::size_t Begin, std::size_t End>
+struct reduce_range<BinaryOperation, Table, Length, Begin, End, false> {
+private:
+  static constexpr std::size_t mid = Begin + (End - Begin) / 2U;
+
+public:
+  using type = fold_step<
+      BinaryOperation,
+      typename reduce_range<BinaryOperation, Table, Length, mid, End>::type,
+      typename reduce_range<BinaryOperation, Table, Length, Begin,
+                            mid>::type>;
+};
+
+}  // end namespace details
+
+/// Combines the members of the list and the initial value by a balanced tree
+/// of applications of BinaryOperation. If the operation is associative, the
+/// result is the same as that of foldl but the instantiation depth grows only
+/// logarithmically with the length of the list. The tree passes members where
+/// foldl passes accumulated values and the reverse, so each member T must be
+/// its own value (T::type is T), as is each std::integral_constant<>.
+template <typename TypeList, typename BinaryOperation, typename Initial>
+TYPE_LIST_CXX20REQUIRES (
+    (is_type_list<TypeList> &&
+     is_binary_operation<BinaryOperation, TypeList, Initial>))
+struct reduce : reduce<to_flat_t<TypeList>, BinaryOperation, Initial> {};
+template <typename BinaryOperation, typename InitialValue>
+struct reduce<flat_list<>, BinaryOperation, InitialValue> {
+  using type = InitialValue;
+};
+template <typename... Types, typename BinaryOperation, typename InitialValue>
+struct reduce<flat_list<Types...>, BinaryOperation, InitialValue> {
+private:
+  using table = details::shared_table<flat_list<Types...>>;
+  static_assert ((TYPE_LIST_IS_SAME (typename Types::type, Types) && ...),
+                 "each member of a list passed to reduce must be its own "
+                 "value: T::type must be T");
+
+public:
+  using type = details::fold_step<
+      BinaryOperation,
+      typename details::reduce_range<BinaryOperation, typename table::type,
+                                     table::length, 0U,
+                                     sizeof...(Types)>::type,
+      InitialValue>;
+};
+
+template <typename TypeList, typename BinaryOperation, typename Initial>
+using reduce_t = typename reduce<TypeList, BinaryOperation, Initial>::type;
+
+namespace details {
+
+/// A class which has element<T> as a base for each member T of a flat list.
+/// Members are wrapped in lookup_entry<> so that a repeated member does not
+/// name the same direct base twice. Whether the list contains T is then
+/// answered by a single base class test rather than a search of the list.
+template <std::size_t Index, typename T>
+struct lookup_entry : element<T> {};
+template <typename FlatList, typename Sequence>
+struct lookup;
+template <typename... Types, std::size_t... Indices>
+struct lookup<flat_list<Types...>, std::index_sequence<Indices...>>
+    : lookup_entry<Indices, Types>... {};
+template <typename TypeList>
+using lookup_t = lookup<to_flat_t<TypeList>,
+                        std::make_index_sequence<size_v<to_flat_t<TypeList>>>>;
+
+/// A unary predicate which holds for the members of TypeList.
+template <typename TypeList>
+struct member_of {
+  template <typename T>
+  using type =
+      std::bool_constant<TYPE_LIST_IS_BASE_OF (element<T>, lookup_t<TypeList>)>;
+};
+template <typename TypeList>
+struct not_member_of {
+  template <typename T>
+  using type = std::bool_constant<!member_of<TypeList>::template type<T>::value>;
+};
+
+/// A class which has element<T> as a base for each member T of blocks [Begin,
+/// End) of the list of blocks indexed by Table. A range of more than one block
+/// derives from the ranges of its two halves, so the ranges needed by every
+/// block of a list share their bases and number at most twice the blocks.
+template <typename Table, std::size_t Begin, std::size_t End,
+          bool IsSingle = (End - Begin == 1U)>
+struct block_range
+    : block_range<Table, Begin, Begin + (End - Begin) / 2U>,
+      block_range<Table, Begin + (End - Begin) / 2U, End> {};
+template <typename Table, std::size_t Begin, std::size_t End>
+struct block_range<Table, Begin, End, true>
+    : lookup_t<typename decltype (details::select<Begin> (
+          static_cast<Table const*> (nullptr)))::type> {};
+
+/// Yields a flat_list of the block_range<>s which together cover blocks [0,
+/// End): one for each bit set in End.
+template <typename Table, std::size_t End>
+struct ranges_before
+    : join<typename ranges_before<Table, (End & (End - 1U))>::type,
+           flat_list<block_range<Table, (End & (End - 1U)), End>>> {};
+template <typename Table>
+struct ranges_before<Table, 0U> {
+  using type = flat_list<>;
+};
+
+/// True if element<T> is a base of any of Ranges.
+template <typename T, typename... Ranges>
+inline constexpr bool in_any_range =
+    (TYPE_LIST_IS_BASE_OF (element<T>, Ranges) || ...);
+
+/// Returns true if T is not among the first index members of Types.
+template <typename T, typename... Types>
+constexpr bool first_occurrence (std::size_t index) {
+  constexpr bool same[] = {TYPE_LIST_IS_SAME (T, Types)..., false};
+  for (std::size_t i = 0; i < index; ++i) {
+    if (same[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <bool Keep, typename T>
+struct kept {
+  using type = flat_list<>;
+};
+template <typename T>
+struct kept<true, T> {
+  using type = flat_list<T>;
+};
+
+/// Yields the members of Block which satisfy UnaryPredicate and appear neither
+/// in any of Ranges nor earlier in Block.
+template <typename Ranges, typename Block, typename UnaryPredicate,
+          typename Indices = index_pack_t<size_v<Block>>>
+struct block_survivors;
+template <typename... Ranges, typename... Types, typename UnaryPredicate,
+          std::size_t... Indices>
+struct block_survivors<flat_list<Ranges...>, flat_list<Types...>,
+                       UnaryPredicate, std::index_sequence<Indices...>>
+    : join<typename kept<(UnaryPredicate::template type<Types>::value &&
+                          !in_any_range<Types, Ranges...> &&
+                          first_occurrence<Types, Types...> (Indices)),
+                         Types>::type...> {};
+
+template <typename Table, typename BlockList, typename UnaryPredicate,
+          typename Sequence = index_pack_t<size_v<BlockList>>>
+struct set_blocks;
+template <typename Table, typename... Blocks, typename UnaryPredicate,
+          std::size_t... Indices>
+struct set_blocks<Table, flat_list<Blocks...>, UnaryPredicate,
+                  std::index_sequence<Indices...>>
+    : join<typename block_survivors<
+          typename ranges_before<Table, Indices>::type, Blocks,
+          UnaryPredicate>::type...> {};
+
+struct always {
+  template <typename T>
+  using type = std::true_type;
+};
+
+/// Yields the members of FlatList, without repeats, which satisfy
+/// UnaryPredicate. The list is gathered into blocks of 64 members. A member
+/// survives if it is not repeated earlier in its block, which is a short
+/// search, and is not present in an earlier block, which is a base class test
+/// on a handful of classes that each derive from a run of earlier blocks. The
+/// cost is roughly linear in the length of the list rather than quadratic.
+template <typename Model, typename FlatList, typename UnaryPredicate,
+          bool IsShort = (size_v<FlatList> <= 64U)>
+struct build_set
+    : same_representation<
+          Model, typename block_survivors<flat_list<>, FlatList,
+                                          UnaryPredicate>::type> {};
+template <typename Model, typename FlatList, typename UnaryPredicate>
+struct build_set<Model, FlatList, UnaryPredicate, false>
+    : same_representation<
+          Model,
+          typename set_blocks<
+              typename table_of<typename blocks<FlatList, 64U>::type>::type,
+              typename blocks<FlatList, 64U>::type, UnaryPredicate>::type> {};
+
+}  // end namespace details
+
+// unique
+// ~~~~~~
+/// Yields the members of TypeList with every member after the first
+/// occurrence of a type removed. The result has the same representation as
+/// TypeList.
+template <typename TypeList>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct unique : details::build_set<TypeList, to_flat_t<TypeList>,
+                                   details::always> {};
+template <typename TypeList>
+using unique_t = typename unique<TypeList>::type;
+
+// set union
+// ~~~~~~~~~
+/// Yields the members of TypeList1 followed by the members of TypeList2 which
+/// are not in TypeList1. Each type appears once in the result.
+template <typename TypeList1, typename TypeList2>
+TYPE_LIST_CXX20REQUIRES ((is_type_list<TypeList1> && is_type_list<TypeList2>))
+struct set_union
+    : details::build_set<TypeList1, concat_t<to_flat_t<TypeList1>, TypeList2>,
+                         details::always> {};
+template <typename TypeList1, typename TypeList2>
+using set_union_t = typename set_union<TypeList1, TypeList2>::type;
+
+// set intersection
+// ~~~~~~~~~~~~~~~~
+/// Yields the members of TypeList1 which are also members of TypeList2. Each
+/// type appears once in the result.
+template <typename TypeList1, typename TypeList2>
+TYPE_LIST_CXX20REQUIRES ((is_type_list<TypeList1> && is_type_list<TypeList2>))
+struct set_intersection
+    : details::build_set<TypeList1, to_flat_t<TypeList1>,
+                         details::member_of<TypeList2>> {};
+template <typename TypeList1, typename TypeList2>
+using set_intersection_t =
+    typename set_intersection<TypeList1, TypeList2>::type;
+
+// set difference
+// ~~~~~~~~~~~~~~
+/// Yields the members of TypeList1 which are not members of TypeList2. Each
+/// type appears once in the result.
+template <typename TypeList1, typename TypeList2>
+TYPE_LIST_CXX20REQUIRES ((is_type_list<TypeList1> && is_type_list<TypeList2>))
+struct set_difference
+    : details::build_set<TypeList1, to_flat_t<TypeList1>,
+                         details::not_member_of<TypeList2>> {};
+template <typename TypeList1, typename TypeList2>
+using set_difference_t = typename set_difference<TypeList1, TypeList2>::type;
+
+// sort
+// ~~~~
+namespace details {
+
+/// Yields the common type of a pack of types by a fold expression rather than
+/// by the recursion of std::common_type<>.
+template <typename T>
+struct common_state {
+  using type = T;
+};
+template <typename T, typename U>
+common_state<std::common_type_t<T, U>> operator+ (common_state<T>,
+                                                  common_state<U>);
+template <typename... Types>
+struct common_fold {
+  using type =
+      typename decltype ((std::declval<common_state<Types>> () + ...))::type;
+};
+
+/// The type of the key KeyOp::type<T>::value.
+template <typename KeyOp, typename T>
+using key_type_t =
+    std::remove_cv_t<decltype (KeyOp::template type<T>::value)>;
+
+/// The type to which sort keys of types KeyTypes are converted: their common
+/// type, except that a mix of signed and unsigned integer keys (whose common
+/// type is unsigned, so that a negative key would compare as a large one) is
+/// held as std::intmax_t.
+template <typename... KeyTypes>
+struct sort_key {
+  using common = typename common_fold<KeyTypes...>::type;
+  using type = std::conditional_t<std::is_integral_v<common> &&
+                                      std::is_unsigned_v<common> &&
+                                      (std::is_signed_v<KeyTypes> || ...),
+                                  std::intmax_t, common>;
+};
+
+/// An array of member indices.
+template <std::size_t Size>
+struct index_array {
+  std::size_t values[Size];
+};
+
+/// Yields std::index_sequence<Array::value.values[I]...> for each I of
+/// Sequence. The array is read from a class other than the one performing the
+/// expansion, which avoids the copies described at first_true.
+template <typename Array, typename Sequence>
+struct array_sequence;
+template <typename Array, std::size_t... Indices>
+struct array_sequence<Array, std::index_sequence<Indices...>> {
+  using type = std::index_sequence<Array::value.values[Indices]...>;
+};
+
+/// Compares two keys. The common orderings are applied directly: a call of
+/// std::less<>::operator() costs a constexpr evaluation many times the cost
+/// of the comparison.
+template <typename Compare, typename Key>
+constexpr bool key_less (Compare const& compare, Key const& a, Key const& b) {
+  return compare (a, b);
+}
+template <typename Key>
+constexpr bool key_less (std::less<> const&, Key const& a, Key const& b) {
+  return a < b;
+}
+template <typename Key>
+constexpr bool key_less (std::greater<> const&, Key const& a, Key const& b) {
+  return b < a;
+}
+
+/// Yields the indices of keys in the order given by a stable sort of the keys.
+/// This is a bottom-up merge sort: a member of the right-hand run is taken
+/// only if it compares less than the member of the left-hand run, so equal
+/// keys keep their original order. The keys are passed as arguments and
+/// copied to a local array, as in first_true.
+template <typename Compare, typename Key, typename... Keys>
+constexpr index_array<sizeof...(Keys) + 1U> stable_order (Compare compare,
+                                                          Key head,
+                                                          Keys... rest) {
+  constexpr std::size_t size = sizeof...(Keys) + 1U;
+  Key const keys[] = {head, static_cast<Key> (rest)...};
+  index_array<size> first{};
+  index_array<size> second{};
+  std::size_t* from = first.values;
+  std::size_t* to = second.values;
+  for (std::size_t index = 0; index < size; ++index) {
+    from[index] = index;
+  }
+  for (std::size_t width = 1; width < size; width *= 2U) {
+    for (std::size_t lo = 0; lo < size; lo += 2U * width) {
+      std::size_t const mid = lo + width < size ? lo + width : size;
+      std::size_t const hi = lo + 2U * width < size ? lo + 2U * width : size;
+      std::size_t left = lo;
+      std::size_t right = mid;
+      for (std::size_t out = lo; out < hi; ++out) {
+        if (left < mid &&
+            (right >= hi ||
+             !key_less (compare, keys[from[right]], keys[from[left]]))) {
+          to[out] = from[left++];
+        } else {
+          to[out] = from[right++];
+        }
+      }
+    }
+    std::size_t* const swap = from;
+    from = to;
+    to = swap;
+  }
+  return from == first.values ? first : second;
+}
+
+/// The order of the members Types given by a stable sort of their keys, each
+/// converted to Key.
+template <typename KeyOp, typename Compare, typename Key, typename... Types>
+struct sort_order {
+  static constexpr index_array<sizeof...(Types)> value = stable_order (
+      Compare{}, static_cast<Key> (KeyOp::template type<Types>::value)...);
+};
+
+/// Sorts the members of a flat list by the keys yielded by KeyOp. The keys are
+/// sorted by a constexpr function so that the instantiation depth does not
+/// depend on the length of the list. Keys are compared as the type given by
+/// sort_key.
+template <typename FlatList, typename KeyOp, typename Compare>
+struct sort_flat;
+template <typename KeyOp, typename Compare>
+struct sort_flat<flat_list<>, KeyOp, Compare> {
+  using type = flat_list<>;
+};
+template <typename First, typename... Rest, typename KeyOp, typename Compare>
+struct sort_flat<flat_list<First, Rest...>, KeyOp, Compare>
+    : pick<flat_list<First, Rest...>,
+           typename array_sequence<
+               sort_order<KeyOp, Compare,
+                          typename sort_key<key_type_t<KeyOp, First>,
+                                            key_type_t<KeyOp, Rest>...>::type,
+                          First, Rest...>,
+               index_pack_t<sizeof...(Rest) + 1U>>::type> {};
+
+}  // end namespace details
+
+/// Yields the members of TypeList ordered by the keys KeyOp::type<T>::value.
+/// KeyOp has the same form as the unary operation accepted by transform (for
+/// example, type_size or type_align). Keys are ordered by Compare; the sort is
+/// stable so members with equal keys retain their relative order. The result
+/// has the same representation as TypeList.
+template <typename TypeList, typename KeyOp, typename Compare = std::less<>>
+TYPE_LIST_CXX20REQUIRES ((is_type_list<TypeList> &&
+                          is_unary_operation<KeyOp, TypeList>))
+struct sort
+    : details::same_representation<
+          TypeList, typename details::sort_flat<to_flat_t<TypeList>, KeyOp,
+                                                Compare>::type> {};
+template <typename TypeList, typename KeyOp, typename Compare = std::less<>>
+using sort_t = typename sort<TypeList, KeyOp, Compare>::type;
+
+// views
+// ~~~~~
+/// A lazy view of TypeList (a type list or another view) whose members are
+/// the members of TypeList transformed by UnaryOperation. Every algorithm
+/// accepts a view, but no list is built until the view is consumed: to_flat,
+/// size, at and foldl expand it directly and the other algorithms convert it
+/// with to_flat. A chain of views is then expanded in a single step: each
+/// member of the underlying list passes through every stage of the chain and
+/// only the final list is instantiated.
+template <typename TypeList, typename UnaryOperation>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct transform_view : details::view_base {};
+
+/// A lazy view of the members of TypeList for which UnaryPredicate holds.
+template <typename TypeList, typename UnaryPredicate>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct filter_view : details::view_base {};
+
+/// A lazy view of the first Count members of TypeList (or of all of its
+/// members if it has fewer than Count). Below a take_view which holds no
+/// filter_view, the members beyond the first Count are never examined.
+template <typename TypeList, std::size_t Count>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct take_view : details::view_base {};
+
+namespace details {
+
+inline constexpr std::size_t unlimited = static_cast<std::size_t> (-1);
+
+/// Describes how a view is expanded: 'source' is the flat list underlying the
+/// chain of views; apply<T> is the type yielded by a member T of the source
+/// once it has passed through every stage; keep<T> is true if the member
+/// survives every filter; 'exact' is true if there are no filters (so that
+/// every member is kept); 'limit' is the largest number of members that the
+/// view may yield. The primary template describes a list which is not a view.
+template <typename TypeList>
+struct view_traits {
+  using source = to_flat_t<TypeList>;
+  template <typename T>
+  using apply = T;
+  template <typename T>
+  static constexpr bool keep = true;
+  static constexpr bool exact = true;
+  static constexpr std::size_t limit = unlimited;
+};
+
+template <typename TypeList, typename UnaryOperation>
+struct view_traits<transform_view<TypeList, UnaryOperation>>
+    : view_traits<TypeList> {
+  template <typename T>
+  using apply = typename UnaryOperation::template type<
+      typename view_traits<TypeList>::template apply<T>>::type;
+};
+
+/// The predicate of a filter is only applied to a member that has survived
+/// the preceding filters, so the stages between are never applied to a
+/// member that has been dropped.
+template <bool Kept, typename UnaryPredicate, typename Traits, typename T>
+struct filter_keep : std::false_type {};
+template <typename UnaryPredicate, typename Traits, typename T>
+struct filter_keep<true, UnaryPredicate, Traits, T>
+    : std::bool_constant<static_cast<bool> (
+          UnaryPredicate::template type<
+              typename Traits::template apply<T>>::value)> {};
+
+template <typename Traits, typename UnaryPredicate>
+struct filter_traits : Traits {
+  template <typename T>
+  static constexpr bool keep =
+      filter_keep<Traits::template keep<T>, UnaryPredicate, Traits, T>::value;
+  static constexpr bool exact = false;
+};
+
+/// A filter below which there is a take_view must be applied to the members
+/// which remain after the take, so the view below is expanded first.
+template <typename TypeList, typename UnaryPredicate,
+          bool IsLimited = (view_traits<TypeList>::limit != unlimited)>
+struct filter_view_traits
+    : filter_traits<view_traits<TypeList>, UnaryPredicate> {};
+template <typename TypeList, typename UnaryPredicate>
+struct filter_view_traits<TypeList, UnaryPredicate, true>
+    : filter_traits<view_traits<to_flat_t<TypeList>>, UnaryPredicate> {};
+
+template <typename TypeList, typename UnaryPredicate>
+struct view_traits<filter_view<TypeList, UnaryPredicate>>
+    : filter_view_traits<TypeList, UnaryPredicate> {};
+
+template <typename TypeList, std::size_t Count>
+struct view_traits<take_view<TypeList, Count>> : view_traits<TypeList> {
+  static constexpr std::size_t limit =
+      view_traits<TypeList>::limit < Count ? view_traits<TypeList>::limit
+                                           : Count;
+};
+
+/// Yields the positions of the true values among Flags. Only the first
+/// count_true<Flags...>() entries of the result are meaningful.
+template <bool... Flags>
+constexpr index_array<sizeof...(Flags) + 1U> true_positions () {
+  bool const flags[] = {Flags..., false};
+  index_array<sizeof...(Flags) + 1U> result{};
+  std::size_t count = 0;
+  for (std::size_t index = 0; index < sizeof...(Flags); ++index) {
+    if (flags[index]) {
+      result.values[count++] = index;
+    }
+  }
+  return result;
+}
+template <bool... Flags>
+constexpr std::size_t count_true () {
+  bool const flags[] = {Flags..., false};
+  std::size_t count = 0;
+  for (std::size_t index = 0; index < sizeof...(Flags); ++index) {
+    count += flags[index] ? 1U : 0U;
+  }
+  return count;
+}
+
+/// The positions of the true values among Flags ('value') and their number
+/// ('count'). These are held by a class of their own so that array_sequence
+/// reads them from outside the class which evaluates the flags.
+template <bool... Flags>
+struct flag_positions {
+  static constexpr std::size_t count = count_true<Flags...> ();
+  static constexpr index_array<sizeof...(Flags) + 1U> value =
+      true_positions<Flags...> ();
+};
+
+/// Passes each member of FlatList through every stage of a view.
+template <typename Traits, typename FlatList>
+struct apply_stages;
+template <typename Traits, typename... Types>
+struct apply_stages<Traits, flat_list<Types...>> {
+  using type = flat_list<typename Traits::template apply<Types>...>;
+};
+
+/// Expands a view to a flat_list. If the view holds no filter, the source is
+/// cut to the view's limit before any stage is applied. Otherwise, keep<T> is
+/// evaluated for each member of the source and the survivors are picked out
+/// by pick<>.
+template <typename View, typename Traits = view_traits<View>,
+          typename Source = typename Traits::source,
+          bool Exact = Traits::exact>
+struct materialize;
+template <typename View, typename Traits, typename... Types>
+struct materialize<View, Traits, flat_list<Types...>, true> {
+  static constexpr std::size_t size =
+      clamp_count (Traits::limit, sizeof...(Types));
+  using type = typename apply_stages<
+      Traits, typename pick<flat_list<Types...>,
+                            index_pack_t<size>>::type>::type;
+};
+template <typename View, typename Traits, typename... Types>
+struct materialize<View, Traits, flat_list<Types...>, false> {
+private:
+  using kept = flag_positions<Traits::template keep<Types>...>;
+
+public:
+  static constexpr std::size_t size = clamp_count (Traits::limit, kept::count);
+  using type = typename apply_stages<
+      Traits, typename pick<flat_list<Types...>,
+                            typename array_sequence<
+                                kept, index_pack_t<size>>::type>::type>::type;
+};
+
+}  // end namespace details
+
+template <typename TypeList, typename UnaryOperation>
+struct to_flat<transform_view<TypeList, UnaryOperation>>
+    : details::materialize<transform_view<TypeList, UnaryOperation>> {};
+template <typename TypeList, typename UnaryPredicate>
+struct to_flat<filter_view<TypeList, UnaryPredicate>>
+    : details::materialize<filter_view<TypeList, UnaryPredicate>> {};
+template <typename TypeList, std::size_t Count>
+struct to_flat<take_view<TypeList, Count>>
+    : details::materialize<take_view<TypeList, Count>> {};
+
+namespace details {
+
+template <typename TypeList, typename UnaryOperation, typename FlatList>
+struct same_representation<transform_view<TypeList, UnaryOperation>, FlatList>
+    : same_representation<TypeList, FlatList> {};
+template <typename TypeList, typename UnaryPredicate, typename FlatList>
+struct same_representation<filter_view<TypeList, UnaryPredicate>, FlatList>
+    : same_representation<TypeList, FlatList> {};
+template <typename TypeList, std::size_t Count, typename FlatList>
+struct same_representation<take_view<TypeList, Count>, FlatList>
+    : same_representation<TypeList, FlatList> {};
+
+}  // end namespace details
+
+template <typename TypeList, typename UnaryOperation>
+struct size<transform_view<TypeList, UnaryOperation>>
+    : std::integral_constant<std::size_t,
+                             details::materialize<transform_view<
+                                 TypeList, UnaryOperation>>::size> {};
+template <typename TypeList, typename UnaryPredicate>
+struct size<filter_view<TypeList, UnaryPredicate>>
+    : std::integral_constant<std::size_t,
+                             details::materialize<filter_view<
+                                 TypeList, UnaryPredicate>>::size> {};
+template <typename TypeList, std::size_t Count>
+struct size<take_view<TypeList, Count>>
+    : std::integral_constant<
+          std::size_t,
+          details::materialize<take_view<TypeList, Count>>::size> {};
+
+template <typename TypeList, typename UnaryOperation,
+          typename BinaryOperation, typename InitialValue>
+struct foldl<transform_view<TypeList, UnaryOperation>, BinaryOperation,
+             InitialValue>
+    : foldl<to_flat_t<transform_view<TypeList, UnaryOperation>>,
+            BinaryOperation, InitialValue> {};
+template <typename TypeList, typename UnaryPredicate, typename BinaryOperation,
+          typename InitialValue>
+struct foldl<filter_view<TypeList, UnaryPredicate>, BinaryOperation,
+             InitialValue>
+    : foldl<to_flat_t<filter_view<TypeList, UnaryPredicate>>, BinaryOperation,
+            InitialValue> {};
+template <typename TypeList, std::size_t Count, typename BinaryOperation,
+          typename InitialValue>
+struct foldl<take_view<TypeList, Count>, BinaryOperation, InitialValue>
+    : foldl<to_flat_t<take_view<TypeList, Count>>, BinaryOperation,
+            InitialValue> {};
+
+// filter
+// ~~~~~~
+/// Yields the members of TypeList for which UnaryPredicate holds. The
+/// predicate is evaluated once for every member, the positions of the
+/// survivors are found by a constexpr function and the survivors are then
+/// picked out by pick<>. The instantiation depth grows only logarithmically
+/// with the length of the list. The result has the same representation as
+/// TypeList.
+template <typename TypeList, typename UnaryPredicate>
+TYPE_LIST_CXX20REQUIRES ((is_type_list<TypeList> &&
+                          is_unary_operation<UnaryPredicate, TypeList>))
+struct filter
+    : details::same_representation<
+          TypeList, to_flat_t<filter_view<TypeList, UnaryPredicate>>> {};
+template <typename TypeList, typename UnaryPredicate>
+using filter_t = typename filter<TypeList, UnaryPredicate>::type;
+
+// remove if
+// ~~~~~~~~~
+/// Yields the members of TypeList for which UnaryPredicate does not hold. The
+/// result has the same representation as TypeList.
+template <typename TypeList, typename UnaryPredicate>
+TYPE_LIST_CXX20REQUIRES ((is_type_list<TypeList> &&
+                          is_unary_operation<UnaryPredicate, TypeList>))
+struct remove_if : filter<TypeList, details::negate<UnaryPredicate>> {};
+template <typename TypeList, typename UnaryPredicate>
+using remove_if_t = typename remove_if<TypeList, UnaryPredicate>::type;
+
+// partition
+// ~~~~~~~~~
+namespace details {
+
+/// Picks out the members of FlatList whose flag is set ('selected') and those
+/// whose flag is clear ('rejected'). Both picks share the blocks gathered from
+/// FlatList.
+template <typename FlatList, bool... Flags>
+struct split_flat {
+private:
+  using matched = flag_positions<Flags...>;
+  using missed = flag_positions<!Flags...>;
+
+public:
+  using selected = typename pick<
+      FlatList, typename array_sequence<
+                    matched, index_pack_t<matched::count>>::type>::type;
+  using rejected = typename pick<
+      FlatList,
+      typename array_sequence<missed, index_pack_t<missed::count>>::type>::type;
+};
+
+template <typename FlatList, typename UnaryPredicate>
+struct partition_flat;
+template <typename... Types, typename UnaryPredicate>
+struct partition_flat<flat_list<Types...>, UnaryPredicate>
+    : split_flat<flat_list<Types...>,
+                 static_cast<bool> (
+                     UnaryPredicate::template type<Types>::value)...> {};
+
+}  // end namespace details
+
+/// Splits TypeList into the members for which UnaryPredicate holds
+/// ('selected') and those for which it does not ('rejected'). The predicate
+/// is evaluated once for each member. Both lists have the same representation
+/// as TypeList and keep the relative order of their members.
+template <typename TypeList, typename UnaryPredicate>
+TYPE_LIST_CXX20REQUIRES ((is_type_list<TypeList> &&
+                          is_unary_operation<UnaryPredicate, TypeList>))
+struct partition {
+private:
+  using halves = details::partition_flat<to_flat_t<TypeList>, UnaryPredicate>;
+
+public:
+  using selected =
+      typename details::same_representation<TypeList,
+                                            typename halves::selected>::type;
+  using rejected =
+      typename details::same_representation<TypeList,
+                                            typename halves::rejected>::type;
+};
+
+// slicing
+// ~~~~~~~
+namespace details {
+
+/// Yields members [Begin, End) of FlatList in the representation of Model.
+/// The members are picked out by a single pack expansion rather than by
+/// peeling the list one member at a time. An invalid range is reported by
+/// the static_assert rather than by an attempt to build an enormous index
+/// sequence.
+template <typename Model, typename FlatList, std::size_t Begin,
+          std::size_t End,
+          bool IsValid = (Begin <= End && End <= size_v<FlatList>),
+          typename Positions = typename offset_sequence<
+              Begin, index_pack_t<(IsValid ? End - Begin : 0U)>>::type>
+struct slice_flat
+    : same_representation<Model, typename pick<FlatList, Positions>::type> {
+  static_assert (IsValid, "slice range is out of bounds");
+};
+
+}  // end namespace details
+
+/// Yields members [Begin, End) of TypeList. Requires Begin <= End <= the size
+/// of the list. The result has the same representation as TypeList.
+template <typename TypeList, std::size_t Begin, std::size_t End>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct slice
+    : details::slice_flat<TypeList, to_flat_t<TypeList>, Begin, End> {};
+template <typename TypeList, std::size_t Begin, std::size_t End>
+using slice_t = typename slice<TypeList, Begin, End>::type;
+
+/// Yields the first Count members of TypeList, or all of its members if it has
+/// fewer than Count.
+template <typename TypeList, std::size_t Count>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct take
+    : slice<TypeList, 0U,
+            details::clamp_count (Count, size_v<to_flat_t<TypeList>>)> {};
+template <typename TypeList, std::size_t Count>
+using take_t = typename take<TypeList, Count>::type;
+
+/// Yields the members of TypeList which follow the first Count, or an empty
+/// list if it has no more than Count members.
+template <typename TypeList, std::size_t Count>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct drop
+    : slice<TypeList, details::clamp_count (Count, size_v<to_flat_t<TypeList>>),
+            size_v<to_flat_t<TypeList>>> {};
+template <typename TypeList, std::size_t Count>
+using drop_t = typename drop<TypeList, Count>::type;
+
+/// Splits TypeList into its first Count members ('head') and the remainder
+/// ('tail'). The list is converted to its flat form once for both halves.
+template <typename TypeList, std::size_t Count>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct split_at {
+private:
+  using flat = to_flat_t<TypeList>;
+  static constexpr std::size_t mid =
+      details::clamp_count (Count, size_v<flat>);
+
+public:
+  using head = typename details::slice_flat<TypeList, flat, 0U, mid>::type;
+  using tail =
+      typename details::slice_flat<TypeList, flat, mid, size_v<flat>>::type;
+};
+
+// chunk
+// ~~~~~
+namespace details {
+
+template <typename Model, std::size_t Size, std::size_t Count,
+          typename Table, std::size_t Length, typename Sequence>
+struct chunk_flat;
+template <typename Model, std::size_t Size, std::size_t Count,
+          typename Table, std::size_t Length, std::size_t... Chunks>
+struct chunk_flat<Model, Size, Count, Table, Length,
+                  std::index_sequence<Chunks...>>
+    : same_representation<
+          Model,
+          flat_list<typename same_representation<
+              Model, typename pick_table<
+                         Table, Length,
+                         typename offset_sequence<
+                             Chunks * Size,
+                             index_pack_t<clamp_count (
+                                 Size, Count - Chunks * Size)>>::type>::type>::
+                         type...>> {};
+
+}  // end namespace details
+
+/// Yields a list whose members are consecutive runs of Size members of
+/// TypeList; the last run holds the remainder and may be shorter. Every chunk
+/// is picked from one table of the members which is built once and shared by
+/// all of the chunks, so the instantiation depth does not depend on the
+/// length of the list and the cost of each chunk depends only on its size.
+/// The result and each chunk have the same representation as TypeList.
+template <typename TypeList, std::size_t Size>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct chunk
+    : details::chunk_flat<
+          typename details::same_representation<TypeList, flat_list<>>::type,
+          Size, size_v<to_flat_t<TypeList>>,
+          typename details::shared_table<to_flat_t<TypeList>>::type,
+          details::shared_table<to_flat_t<TypeList>>::length,
+          // A size of 0 yields no chunks so that the static_assert below,
+          // rather than a division by zero, reports the error.
+          details::index_pack_t<
+              Size == 0U ? 0U
+                         : (size_v<to_flat_t<TypeList>> + Size - 1U) / Size>> {
+  static_assert (Size > 0U, "chunk size must not be zero");
+};
+template <typename TypeList, std::size_t Size>
+using chunk_t = typename chunk<TypeList, Size>::type;
+
+// rearranging
+// ~~~~~~~~~~~
+namespace details {
+
+/// Yields std::index_sequence<Map::position(I)...> for each I of Sequence.
+template <typename Map, typename Sequence>
+struct mapped_sequence;
+template <typename Map, std::size_t... Indices>
+struct mapped_sequence<Map, std::index_sequence<Indices...>> {
+  using type = std::index_sequence<Map::position (Indices)...>;
+};
+
+/// Yields a list of Count members in the representation of Model, where
+/// member I is the member of FlatList at Map::position(I). The positions are
+/// computed by one pack expansion and the members are then picked out by
+/// pick<>, so the instantiation depth grows only logarithmically with the
+/// length of the list.
+template <typename Model, typename FlatList, typename Map, std::size_t Count,
+          typename Positions =
+              typename mapped_sequence<Map, index_pack_t<Count>>::type>
+struct rearrange
+    : same_representation<Model, typename pick<FlatList, Positions>::type> {};
+
+template <std::size_t Size>
+struct reverse_map {
+  static constexpr std::size_t position (std::size_t index) {
+    return Size - 1U - index;
+  }
+};
+template <std::size_t Size, std::size_t Distance>
+struct rotate_map {
+  static constexpr std::size_t position (std::size_t index) {
+    return (index + Distance) % Size;
+  }
+};
+/// Positions into a flat list whose last member follows the original
+/// members. Member Index is taken from that last member; the original members
+/// which follow Index move up by one.
+template <std::size_t Size, std::size_t Index>
+struct insert_map {
+  static constexpr std::size_t position (std::size_t index) {
+    return index < Index ? index : index == Index ? Size : index - 1U;
+  }
+};
+template <std::size_t Index>
+struct erase_map {
+  static constexpr std::size_t position (std::size_t index) {
+    return index < Index ? index : index + 1U;
+  }
+};
+/// As insert_map, but the member at Index is replaced rather than moved.
+template <std::size_t Size, std::size_t Index>
+struct replace_map {
+  static constexpr std::size_t position (std::size_t index) {
+    return index == Index ? Size : index;
+  }
+};
+
+}  // end namespace details
+
+/// Yields the members of TypeList in reverse order. The result has the same
+/// representation as TypeList.
+template <typename TypeList>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct reverse
+    : details::rearrange<TypeList, to_flat_t<TypeList>,
+                         details::reverse_map<size_v<to_flat_t<TypeList>>>,
+                         size_v<to_flat_t<TypeList>>> {};
+template <typename TypeList>
+using reverse_t = typename reverse<TypeList>::type;
+
+/// Rotates the members of TypeList to the left by Distance places, so that
+/// the member at index Distance (modulo the size of the list) comes first.
+template <typename TypeList, std::size_t Distance>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct rotate
+    : details::rearrange<
+          TypeList, to_flat_t<TypeList>,
+          details::rotate_map<size_v<to_flat_t<TypeList>>, Distance>,
+          size_v<to_flat_t<TypeList>>> {};
+template <typename TypeList, std::size_t Distance>
+using rotate_t = typename rotate<TypeList, Distance>::type;
+
+/// Yields TypeList with T inserted before the member at Index. Index may be
+/// the size of the list, in which case T is appended.
+template <typename TypeList, std::size_t Index, typename T>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct insert_at
+    : details::rearrange<
+          TypeList, push_back_t<to_flat_t<TypeList>, T>,
+          details::insert_map<size_v<to_flat_t<TypeList>>, Index>,
+          size_v<to_flat_t<TypeList>> + 1U> {
+  static_assert (Index <= size_v<to_flat_t<TypeList>>,
+                 "insert_at<> index is out of range");
+};
+template <typename TypeList, std::size_t Index, typename T>
+using insert_at_t = typename insert_at<TypeList, Index, T>::type;
+
+/// Yields TypeList without the member at Index.
+template <typename TypeList, std::size_t Index>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct erase_at
+    : details::rearrange<
+          TypeList, to_flat_t<TypeList>, details::erase_map<Index>,
+          (Index < size_v<to_flat_t<TypeList>>
+               ? size_v<to_flat_t<TypeList>> - 1U
+               : 0U)> {
+  static_assert (Index < size_v<to_flat_t<TypeList>>,
+                 "erase_at<> index is out of range");
+};
+template <typename TypeList, std::size_t Index>
+using erase_at_t = typename erase_at<TypeList, Index>::type;
+
+/// Yields TypeList with the member at Index replaced by T.
+template <typename TypeList, std::size_t Index, typename T>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct replace_at
+    : details::rearrange<
+          TypeList, push_back_t<to_flat_t<TypeList>, T>,
+          details::replace_map<size_v<to_flat_t<TypeList>>, Index>,
+          size_v<to_flat_t<TypeList>>> {
+  static_assert (Index < size_v<to_flat_t<TypeList>>,
+                 "replace_at<> index is out of range");
+};
+template <typename TypeList, std::size_t Index, typename T>
+using replace_at_t = typename replace_at<TypeList, Index, T>::type;
 
 }  // end namespace type_list
 
@@ -0,0 +1,139 @@
+/// \file type_map.hpp
+/// \brief Implements type_map: a compile-time map from key types to value
+/// types.
+//
+// Copyright 2022 Paul Bowen-Huggett
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TYPE_MAP_HPP
+#define TYPE_MAP_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "type_list.hpp"
+
+namespace type_list {
+
+namespace details {
+
+/// The base of a type_map which records that Key maps to Value.
+template <typename Key, typename Value>
+struct map_entry {
+  using type = Value;
+};
+/// Entries are wrapped in map_slot<> so that the bases of a map are distinct
+/// even if the list names the same entry twice.
+template <std::size_t Index, typename Key, typename Value>
+struct map_slot : map_entry<Key, Value> {};
+
+template <typename T>
+struct map_key;
+template <template <typename, typename> class Pair, typename Key,
+          typename Value>
+struct map_key<Pair<Key, Value>> {
+  using type = Key;
+};
+struct key_of {
+  template <typename T>
+  using type = map_key<T>;
+};
+
+template <typename FlatList, typename Sequence>
+struct map_base;
+template <template <typename, typename> class... Pairs, typename... Keys,
+          typename... Values, std::size_t... Indices>
+struct map_base<flat_list<Pairs<Keys, Values>...>,
+                std::index_sequence<Indices...>>
+    : map_slot<Indices, Keys, Values>... {};
+
+/// The result of a search for a key which is not in the map.
+struct no_entry {};
+
+/// Picks out the entry for Key by overload resolution against the bases of a
+/// map. The conversion to a base is preferred to the conversion to void
+/// const*, so the second overload is chosen only if there is no such entry.
+template <typename Key, typename Value>
+map_entry<Key, Value> map_select (map_entry<Key, Value> const*);
+template <typename Key>
+no_entry map_select (void const*);
+
+template <typename Entry, typename Default>
+struct map_value : Entry {};
+template <typename Default>
+struct map_value<no_entry, Default> {
+  using type = Default;
+};
+
+}  // end namespace details
+
+// type map
+// ~~~~~~~~
+/// A map from key types to value types. Each member of TypeList is an instance
+/// of a two parameter template, such as std::pair<Key, Value>, which maps Key
+/// to Value. The map derives from a class for each entry so that a key is
+/// found by a single overload resolution rather than by a search of the list.
+/// Keys must be distinct.
+template <typename TypeList>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct type_map
+    : details::map_base<to_flat_t<TypeList>,
+                        std::make_index_sequence<size_v<to_flat_t<TypeList>>>> {
+  using entries = TypeList;
+  using keys = transform_t<to_flat_t<TypeList>, details::key_of>;
+  static_assert (size_v<unique_t<keys>> == size_v<keys>,
+                 "The keys of a type_map must be distinct");
+};
+
+// lookup or
+// ~~~~~~~~~
+/// Yields the value to which Map maps Key, or Default if Map has no entry for
+/// Key.
+template <typename Map, typename Key, typename Default>
+struct lookup_or
+    : details::map_value<decltype (details::map_select<Key> (
+                             static_cast<Map const*> (nullptr))),
+                         Default> {};
+template <typename Map, typename Key, typename Default>
+using lookup_or_t = typename lookup_or<Map, Key, Default>::type;
+
+// lookup
+// ~~~~~~
+/// Yields the value to which Map maps Key. It is an error if Map has no entry
+/// for Key.
+template <typename Map, typename Key>
+struct lookup {
+private:
+  using entry = decltype (details::map_select<Key> (
+      static_cast<Map const*> (nullptr)));
+  static_assert (!std::is_same_v<entry, details::no_entry>,
+                 "The type_map has no entry for the key");
+
+public:
+  using type = typename entry::type;
+};
+template <typename Map, typename Key>
+using lookup_t = typename lookup<Map, Key>::type;
+
+/// Yields true if Map has an entry for Key.
+template <typename Map, typename Key>
+inline constexpr bool has_key_v =
+    !std::is_same_v<decltype (details::map_select<Key> (
+                        static_cast<Map const*> (nullptr))),
+                    details::no_entry>;
+
+}  // end namespace type_list
+
+#endif  // TYPE_MAP_HPP
@@ -0,0 +1,119 @@
+/// \file type_table.hpp
+/// \brief Implements type_table: constant tables of the characteristics of the
+/// members of a type list, indexed by the position of each member.
+//
+// Copyright 2022 Paul Bowen-Huggett
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TYPE_TABLE_HPP
+#define TYPE_TABLE_HPP
+
+#include <array>
+#include <cstddef>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "type_hash.hpp"
+#include "type_list.hpp"
+
+namespace type_list {
+
+namespace details {
+
+template <typename T>
+void destroy_thunk (void* p) noexcept {
+  static_cast<T*> (p)->~T ();
+}
+template <typename T>
+void copy_thunk (void* dest, void const* src) {
+  ::new (dest) T (*static_cast<T const*> (src));
+}
+template <typename T>
+void move_thunk (void* dest, void* src) {
+  ::new (dest) T (std::move (*static_cast<T*> (src)));
+}
+
+using destroy_fn = void (*) (void*) noexcept;
+using copy_fn = void (*) (void*, void const*);
+using move_fn = void (*) (void*, void*);
+
+/// The copy and move table entries for T. Each is null, and the thunk is not
+/// instantiated, if T cannot be constructed in that way.
+template <typename T, bool = std::is_copy_constructible_v<T>>
+inline constexpr copy_fn copy_entry = &copy_thunk<T>;
+template <typename T>
+inline constexpr copy_fn copy_entry<T, false> = nullptr;
+template <typename T, bool = std::is_move_constructible_v<T>>
+inline constexpr move_fn move_entry = &move_thunk<T>;
+template <typename T>
+inline constexpr move_fn move_entry<T, false> = nullptr;
+
+template <typename FlatList>
+struct table_base;
+template <typename... Types>
+struct table_base<flat_list<Types...>> {
+  static constexpr std::size_t size = sizeof...(Types);
+
+  static constexpr std::array<std::string_view, size> names{
+      {type_name_v<Types>...}};
+  static constexpr std::array<std::size_t, size> sizes{{sizeof (Types)...}};
+  static constexpr std::array<std::size_t, size> alignments{
+      {alignof (Types)...}};
+  static constexpr std::array<destroy_fn, size> destroy{
+      {&destroy_thunk<Types>...}};
+  static constexpr std::array<copy_fn, size> copy{{copy_entry<Types>...}};
+  static constexpr std::array<move_fn, size> move{{move_entry<Types>...}};
+};
+
+}  // end namespace details
+
+// type table
+// ~~~~~~~~~~
+/// Constant tables of the characteristics of the members of TypeList. Each
+/// table is a constexpr std::array with one entry for each member, at the
+/// member's position in the list, so that run-time code can find the facts
+/// about a member by loading from a table rather than through RTTI or a hash
+/// of std::type_index. The tables are constant-initialized: none needs a
+/// static initializer.
+///
+/// - names: the name of each member (see type_name_v<>).
+/// - sizes and alignments: sizeof and alignof each member.
+/// - destroy: destroys an object of the member type at the given address.
+/// - copy and move: copy or move construct an object of the member type at the
+///   first address from the object at the second. The entry is null if the
+///   member is not copy (or move) constructible.
+template <typename TypeList>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct type_table : details::table_base<to_flat_t<TypeList>> {};
+
+// type id
+// ~~~~~~~
+/// Yields the position of T in TypeList for use as an index into the tables of
+/// type_table<TypeList>. A chain of type_list cells is converted to a flat_list
+/// so that the position is found by a single scan of a constant array rather
+/// than by recursion. It is an error if T is not a member of the list.
+template <typename TypeList, typename T>
+struct type_id : index_of<to_flat_t<TypeList>, T> {
+  static_assert (index_of<to_flat_t<TypeList>, T>::value <
+                     size_v<to_flat_t<TypeList>>,
+                 "The type is not a member of the list");
+};
+template <typename TypeList, typename T>
+inline constexpr std::size_t type_id_v = type_id<TypeList, T>::value;
+
+}  // end namespace type_list
+
+#endif  // TYPE_TABLE_HPP
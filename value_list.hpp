@@ -0,0 +1,396 @@
+/// \file value_list.hpp
+/// \brief Implements value_list: a compile-time list of non-type template
+/// parameters.
+//
+// Copyright 2022 Paul Bowen-Huggett
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VALUE_LIST_HPP
+#define VALUE_LIST_HPP
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "type_list.hpp"
+
+namespace type_list {
+
+// value list
+// ~~~~~~~~~~
+/// A list of values held in a single template parameter pack. Where a list of
+/// std::integral_constant<> types needs one class for each member, a
+/// value_list is a single class. Its algorithms (in the namespace
+/// type_list::values) copy the values into a constexpr std::array and work on
+/// that with ordinary constexpr loops, so that no template is instantiated for
+/// each member.
+template <auto... Values>
+struct value_list {};
+
+namespace details {
+
+/// Holds Values in an array of type T. The type is a template parameter rather
+/// than a member of the class which computes it, for the reason given at
+/// details::select_each.
+template <typename T, auto... Values>
+struct typed_array {
+  using value_type = T;
+  static constexpr std::array<T, sizeof...(Values)> values{
+      {static_cast<T> (Values)...}};
+};
+
+/// Holds the values of a non-empty list in an array of their common type. In
+/// the usual case every value has the same type as the first, which is
+/// checked by comparing a single pair of value_list<> types rather than by
+/// examining the type of each value in turn.
+template <auto First, auto... Rest>
+struct value_array
+    : typed_array<
+          typename std::conditional_t<
+              std::is_same_v<
+                  value_list<First, static_cast<decltype (First)> (Rest)...>,
+                  value_list<First, Rest...>>,
+              common_state<decltype (First)>,
+              common_fold<decltype (First), decltype (Rest)...>>::type,
+          First, Rest...> {};
+
+/// Yields true if a member of values compares equal to v. Both are compared as
+/// their common type.
+template <typename T, std::size_t Size, typename U>
+constexpr bool array_contains (std::array<T, Size> const& values, U const& v) {
+  using common = std::common_type_t<T, U>;
+  for (std::size_t index = 0; index < Size; ++index) {
+    if (static_cast<common> (values[index]) == static_cast<common> (v)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Restores the heap property of the heap of size end rooted at root.
+template <typename T, typename Compare>
+constexpr void sift_down (T* values, std::size_t root, std::size_t end,
+                          Compare& compare) {
+  for (std::size_t child = 2U * root + 1U; child < end;
+       child = 2U * root + 1U) {
+    if (child + 1U < end && compare (values[child], values[child + 1U])) {
+      ++child;
+    }
+    if (!compare (values[root], values[child])) {
+      break;
+    }
+    T const t = values[root];
+    values[root] = values[child];
+    values[child] = t;
+    root = child;
+  }
+}
+
+/// Sorts an array in place with a heap sort. std::sort() is not constexpr
+/// before C++20. The elements are reached through a pointer rather than
+/// std::array<>::operator[]: each call is costly during constant evaluation.
+template <typename T, std::size_t Size, typename Compare>
+constexpr void heap_sort (std::array<T, Size>& array, Compare compare) {
+  T* const values = array.data ();
+  for (std::size_t index = Size / 2U; index > 0U; --index) {
+    sift_down (values, index - 1U, Size, compare);
+  }
+  for (std::size_t end = Size; end > 1U; --end) {
+    T const t = values[0];
+    values[0] = values[end - 1U];
+    values[end - 1U] = t;
+    sift_down (values, 0U, end - 1U, compare);
+  }
+}
+
+/// The values of a list sorted by Compare.
+template <typename Compare, auto... Values>
+struct sorted_values {
+  static constexpr std::size_t size = sizeof...(Values);
+  static constexpr auto values = [] {
+    auto result = value_array<Values...>::values;
+    heap_sort (result, Compare{});
+    return result;
+  }();
+};
+
+/// A value and its position in a list.
+template <typename T>
+struct ranked {
+  T value{};
+  std::size_t index = 0;
+};
+struct rank_less {
+  template <typename T>
+  constexpr bool operator() (ranked<T> const& a, ranked<T> const& b) const {
+    return a.value < b.value || (!(b.value < a.value) && a.index < b.index);
+  }
+};
+
+template <typename T, std::size_t Size>
+struct unique_result {
+  std::array<T, Size> values{};
+  std::size_t size = 0;
+};
+
+/// Yields the values of an array without the repeats of each value after its
+/// first occurrence. The values are sorted along with their positions so that
+/// only the first of each run of equal values is kept: O(N log N) comparisons
+/// rather than O(N^2).
+template <typename T, std::size_t Size>
+constexpr unique_result<T, Size> unique_values (
+    std::array<T, Size> const& values) {
+  std::array<ranked<T>, Size> order{};
+  for (std::size_t index = 0; index < Size; ++index) {
+    order[index] = ranked<T>{values[index], index};
+  }
+  heap_sort (order, rank_less{});
+  std::array<bool, Size> keep{};
+  for (std::size_t index = 0; index < Size; ++index) {
+    keep[order[index].index] =
+        index == 0U || order[index - 1U].value < order[index].value;
+  }
+  unique_result<T, Size> result;
+  for (std::size_t index = 0; index < Size; ++index) {
+    if (keep[index]) {
+      result.values[result.size++] = values[index];
+    }
+  }
+  return result;
+}
+
+template <auto... Values>
+struct unique_holder {
+private:
+  static constexpr auto result =
+      unique_values (value_array<Values...>::values);
+
+public:
+  static constexpr std::size_t size = result.size;
+  static constexpr auto values = result.values;
+};
+
+/// Yields the value_list of the first Holder::size members of Holder::values.
+template <typename Holder, std::size_t... Indices>
+value_list<Holder::values[Indices]...> expand_values (
+    std::index_sequence<Indices...>);
+template <typename Holder>
+using holder_list_t = decltype (expand_values<Holder> (
+    std::make_index_sequence<Holder::size>{}));
+
+}  // end namespace details
+
+namespace values {
+
+// size
+// ~~~~
+/// Yields the number of values in the list.
+template <typename ValueList>
+struct size;
+template <auto... Values>
+struct size<value_list<Values...>>
+    : std::integral_constant<std::size_t, sizeof...(Values)> {};
+template <typename ValueList>
+inline constexpr std::size_t size_v = size<ValueList>::value;
+
+// contains
+// ~~~~~~~~
+/// Yields true if a member of the list compares equal to Value. The members
+/// and Value are compared as their common type.
+template <typename ValueList, auto Value>
+struct contains;
+template <auto Value>
+struct contains<value_list<>, Value> : std::false_type {};
+template <auto... Values, auto Value>
+struct contains<value_list<Values...>, Value>
+    : std::bool_constant<details::array_contains (
+          details::value_array<Values...>::values, Value)> {};
+template <typename ValueList, auto Value>
+inline constexpr bool contains_v = contains<ValueList, Value>::value;
+
+// transform
+// ~~~~~~~~~
+/// Yields a list of the results of applying UnaryOperation to each of the
+/// members. UnaryOperation is a type with a constexpr function call operator.
+template <typename ValueList, typename UnaryOperation>
+struct transform;
+template <auto... Values, typename UnaryOperation>
+struct transform<value_list<Values...>, UnaryOperation> {
+  using type = value_list<UnaryOperation{}(Values)...>;
+};
+template <typename ValueList, typename UnaryOperation>
+using transform_t = typename transform<ValueList, UnaryOperation>::type;
+
+// fold left
+// ~~~~~~~~~
+/// Combines Initial with each of the members in turn. As with the type list
+/// foldl, BinaryOperation is given the member followed by the accumulated
+/// value; it is a type with a constexpr function call operator.
+template <typename ValueList, typename BinaryOperation, auto Initial>
+struct foldl;
+template <typename BinaryOperation, auto Initial>
+struct foldl<value_list<>, BinaryOperation, Initial> {
+  static constexpr auto value = Initial;
+};
+template <auto... Values, typename BinaryOperation, auto Initial>
+struct foldl<value_list<Values...>, BinaryOperation, Initial> {
+  static constexpr auto value = [] {
+    auto const& values = details::value_array<Values...>::values;
+    auto result = Initial;
+    for (std::size_t index = 0; index < values.size (); ++index) {
+      result = BinaryOperation{}(values.data ()[index], result);
+    }
+    return result;
+  }();
+};
+template <typename ValueList, typename BinaryOperation, auto Initial>
+inline constexpr auto foldl_v = foldl<ValueList, BinaryOperation, Initial>::value;
+
+// sort
+// ~~~~
+/// Yields the members of the list converted to their common type and ordered
+/// by Compare.
+template <typename ValueList, typename Compare = std::less<>>
+struct sort;
+template <typename Compare>
+struct sort<value_list<>, Compare> {
+  using type = value_list<>;
+};
+template <auto... Values, typename Compare>
+struct sort<value_list<Values...>, Compare> {
+  using type =
+      details::holder_list_t<details::sorted_values<Compare, Values...>>;
+};
+template <typename ValueList, typename Compare = std::less<>>
+using sort_t = typename sort<ValueList, Compare>::type;
+
+// unique
+// ~~~~~~
+/// Yields the members of the list converted to their common type with every
+/// repeat of a value after its first occurrence removed. Values are compared
+/// with operator<.
+template <typename ValueList>
+struct unique;
+template <>
+struct unique<value_list<>> {
+  using type = value_list<>;
+};
+template <auto... Values>
+struct unique<value_list<Values...>> {
+  using type = details::holder_list_t<details::unique_holder<Values...>>;
+};
+template <typename ValueList>
+using unique_t = typename unique<ValueList>::type;
+
+// to types
+// ~~~~~~~~
+/// Yields a flat_list of std::integral_constant<> types with the values of
+/// the list.
+template <typename ValueList>
+struct to_types;
+template <auto... Values>
+struct to_types<value_list<Values...>> {
+  using type = flat_list<std::integral_constant<decltype (Values), Values>...>;
+};
+template <typename ValueList>
+using to_types_t = typename to_types<ValueList>::type;
+
+// from types
+// ~~~~~~~~~~
+/// Yields a value_list of the 'value' members of a type list such as a list
+/// of std::integral_constant<> types.
+template <typename TypeList>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct from_types : from_types<to_flat_t<TypeList>> {};
+template <typename... Types>
+struct from_types<flat_list<Types...>> {
+  using type = value_list<Types::value...>;
+};
+template <typename TypeList>
+using from_types_t = typename from_types<TypeList>::type;
+
+}  // end namespace values
+
+// to array
+// ~~~~~~~~
+/// Holds the 'value' members of the types of a non-empty list, such as a list
+/// of std::integral_constant<> types, in a constexpr std::array. The values are
+/// converted to their common type.
+template <typename TypeList>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+struct to_array : to_array<to_flat_t<TypeList>> {};
+// The element type of an empty list cannot be deduced.
+template <>
+struct to_array<flat_list<>>;
+template <typename... Types>
+struct to_array<flat_list<Types...>>
+    : details::value_array<Types::value...> {};
+
+/// The array of the 'value' members of the types of TypeList. This is a
+/// reference to a single array with static storage duration so that lookup
+/// tables computed at compile time can be indexed at run time.
+template <typename TypeList>
+inline constexpr auto const& to_array_v = to_array<TypeList>::values;
+
+// make index list
+// ~~~~~~~~~~~~~~~
+namespace details {
+
+template <typename Sequence>
+struct index_values;
+template <std::size_t... Indices>
+struct index_values<std::index_sequence<Indices...>> {
+  using type = value_list<Indices...>;
+};
+
+}  // end namespace details
+
+/// Yields value_list<0, ..., Count - 1> with values of type std::size_t. The
+/// indices are produced in the same manner as iota_list<>.
+template <std::size_t Count>
+struct make_index_list : details::index_values<details::index_pack_t<Count>> {};
+template <std::size_t Count>
+using make_index_list_t = typename make_index_list<Count>::type;
+
+// from array
+// ~~~~~~~~~~
+namespace details {
+
+template <auto const& Array, typename Sequence>
+struct array_types;
+template <auto const& Array, std::size_t... Indices>
+struct array_types<Array, std::index_sequence<Indices...>> {
+  using value_type =
+      std::remove_cv_t<std::remove_reference_t<decltype (Array[0])>>;
+  using type = flat_list<std::integral_constant<value_type, Array[Indices]>...>;
+};
+
+}  // end namespace details
+
+/// Yields a flat_list of std::integral_constant<> types with the values of
+/// Array, a constexpr std::array with static storage duration (such as
+/// to_array_v<>). The array is passed by reference so that its contents do
+/// not become part of the name of each specialization.
+template <auto const& Array>
+struct from_array
+    : details::array_types<Array, std::make_index_sequence<std::size (Array)>> {};
+template <auto const& Array>
+using from_array_t = typename from_array<Array>::type;
+
+}  // end namespace type_list
+
+#endif  // VALUE_LIST_HPP
@@ -0,0 +1,212 @@
+/// \file visit_index.hpp
+/// \brief Implements visit_index: dispatch from a run-time index to a member of
+/// a type list through a table of function pointers.
+//
+// Copyright 2022 Paul Bowen-Huggett
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VISIT_INDEX_HPP
+#define VISIT_INDEX_HPP
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "type_list.hpp"
+
+namespace type_list {
+
+/// An empty object which carries a member of a type list to a visitor.
+template <typename T>
+struct type_tag {
+  using type = T;
+};
+
+namespace details {
+
+template <typename Function, typename T>
+decltype (auto) visit_thunk (Function&& f) {
+  return std::forward<Function> (f) (type_tag<T>{});
+}
+
+template <typename Function, typename FlatList>
+struct visit_table;
+template <typename Function, typename... Types>
+struct visit_table<Function, flat_list<Types...>> {
+  static_assert (sizeof...(Types) > 0U, "Cannot visit an empty list");
+  using result_type =
+      std::invoke_result_t<Function, type_tag<at_t<flat_list<Types...>, 0>>>;
+  static_assert (
+      (std::is_same_v<result_type,
+                      std::invoke_result_t<Function, type_tag<Types>>> &&
+       ...),
+      "The visitor must return the same type for every member of the list");
+
+  using pointer = result_type (*) (Function&&);
+  static constexpr pointer table[] = {&visit_thunk<Function, Types>...};
+};
+
+}  // end namespace details
+
+// visit index
+// ~~~~~~~~~~~
+/// Calls f(type_tag<T>{}) where T is the member of TypeList at position
+/// index, and returns the result. The call is made through a constant table
+/// holding one function pointer for each member of the list so that the cost
+/// of dispatch is a single indirect call whatever the length of the list.
+/// The index must be less than the size of the list.
+template <typename TypeList, typename Function>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeList>)
+decltype (auto) visit_index (std::size_t index, Function&& f) {
+  using table = details::visit_table<Function&&, to_flat_t<TypeList>>;
+  assert (index < size_v<to_flat_t<TypeList>> &&
+          "visit_index() index is out of range");
+  return table::table[index](std::forward<Function> (f));
+}
+
+// dispatch
+// ~~~~~~~~
+/// The default for the largest number of entries in a single dispatch table.
+inline constexpr std::size_t dispatch_table_limit = 4096U;
+
+namespace details {
+
+template <typename Function, typename... Types>
+decltype (auto) dispatch_thunk (Function&& f) {
+  return std::forward<Function> (f) (type_tag<Types>{}...);
+}
+
+/// Yields the digit of entry in dimension dim of a row-major table whose
+/// dimensions have the given sizes. The last dimension varies fastest.
+template <std::size_t... Sizes>
+constexpr std::size_t table_digit (std::size_t entry, std::size_t dim) {
+  constexpr std::size_t sizes[] = {Sizes...};
+  std::size_t stride = 1U;
+  for (std::size_t d = sizeof...(Sizes) - 1U; d > dim; --d) {
+    stride *= sizes[d];
+  }
+  return entry / stride % sizes[dim];
+}
+
+/// A flattened table of function pointers with one entry for each combination
+/// of the members of FlatLists.
+template <typename Function, typename FlatLists, typename Entries>
+struct dispatch_table;
+template <typename Function, typename... FlatLists, std::size_t... Entries>
+struct dispatch_table<Function, flat_list<FlatLists...>,
+                      std::index_sequence<Entries...>> {
+  using result_type =
+      std::invoke_result_t<Function, type_tag<at_t<FlatLists, 0>>...>;
+  using pointer = result_type (*) (Function&&);
+
+  template <typename... Types>
+  static constexpr pointer thunk () {
+    static_assert (
+        std::is_same_v<result_type,
+                       std::invoke_result_t<Function, type_tag<Types>...>>,
+        "The visitor must return the same type for every combination of "
+        "members");
+    return &dispatch_thunk<Function, Types...>;
+  }
+  template <std::size_t Entry, std::size_t... Dims>
+  static constexpr pointer entry (std::index_sequence<Dims...>) {
+    return thunk<
+        at_t<FlatLists, table_digit<size_v<FlatLists>...> (Entry, Dims)>...> ();
+  }
+  static constexpr pointer table[] = {
+      entry<Entries> (std::index_sequence_for<FlatLists...>{})...};
+
+  /// Yields the table entry for a combination of member indices.
+  static std::size_t index (std::size_t const* indices) noexcept {
+    constexpr std::size_t sizes[] = {size_v<FlatLists>...};
+    std::size_t result = 0;
+    for (std::size_t dim = 0; dim < sizeof...(FlatLists); ++dim) {
+      assert (indices[dim] < sizes[dim] && "dispatch() index is out of range");
+      result = result * sizes[dim] + indices[dim];
+    }
+    return result;
+  }
+};
+
+/// Dispatches on the members of FlatLists at indices. If there are no more
+/// than Limit combinations, the call is made through a single table.
+/// Otherwise, the first list is dispatched by visit_index() and the remainder
+/// recursively so that no table exceeds the limit.
+template <std::size_t Limit, typename... FlatLists>
+struct dispatcher;
+template <std::size_t Limit, typename First, typename... Rest>
+struct dispatcher<Limit, First, Rest...> {
+  static constexpr std::size_t combinations =
+      (size_v<First> * ... * size_v<Rest>);
+  static_assert (combinations > 0U, "Cannot dispatch on an empty list");
+
+  template <typename Function>
+  static decltype (auto) call (std::size_t const* indices, Function&& f) {
+    if constexpr (combinations <= Limit || sizeof...(Rest) == 0U) {
+      using table =
+          dispatch_table<Function&&, flat_list<First, Rest...>,
+                         std::make_index_sequence<combinations>>;
+      return table::table[table::index (indices)](std::forward<Function> (f));
+    } else {
+      return visit_index<First> (
+          indices[0], [indices, &f] (auto tag) -> decltype (auto) {
+            return dispatcher<Limit, Rest...>::call (
+                indices + 1, [tag, &f] (auto... tags) -> decltype (auto) {
+                  return std::forward<Function> (f) (tag, tags...);
+                });
+          });
+    }
+  }
+};
+template <std::size_t Limit, typename... TypeLists>
+dispatcher<Limit, to_flat_t<TypeLists>...> make_dispatcher (
+    flat_list<TypeLists...>*);
+
+}  // end namespace details
+
+/// Calls f(type_tag<T0>{}, type_tag<T1>{}, ...) where each Tk is the member of
+/// the k'th list of TypeLists (a type list whose members are type lists) at
+/// position indices[k], and returns the result. The call is made through a
+/// single constant table with an entry for each combination of members, so
+/// that the cost of dispatch is one indirect call. If there are more than
+/// Limit combinations, the leading lists are dispatched one at a time through
+/// visit_index() until the remainder fit in a table. The visitor must return
+/// the same type for every combination.
+template <typename TypeLists, std::size_t Limit = dispatch_table_limit,
+          typename Function>
+TYPE_LIST_CXX20REQUIRES (is_type_list<TypeLists>)
+decltype (auto) dispatch (
+    std::array<std::size_t, size_v<TypeLists>> const& indices, Function&& f) {
+  using dispatcher = decltype (details::make_dispatcher<Limit> (
+      static_cast<to_flat_t<TypeLists>*> (nullptr)));
+  return dispatcher::call (indices.data (), std::forward<Function> (f));
+}
+
+/// Calls f(type_tag<A>{}, type_tag<B>{}) where A is the member of TypeList1 at
+/// index1 and B is the member of TypeList2 at index2 through a single
+/// flattened table of function pointers.
+template <typename TypeList1, typename TypeList2,
+          std::size_t Limit = dispatch_table_limit, typename Function>
+TYPE_LIST_CXX20REQUIRES ((is_type_list<TypeList1> && is_type_list<TypeList2>))
+decltype (auto) dispatch2 (std::size_t index1, std::size_t index2,
+                           Function&& f) {
+  return dispatch<flat_list<TypeList1, TypeList2>, Limit> (
+      {{index1, index2}}, std::forward<Function> (f));
+}
+
+}  // end namespace type_list
+
+#endif  // VISIT_INDEX_HPP